@@ -0,0 +1,261 @@
+/*
+    pybind11/asyncio.h: Returning asyncio awaitables from C++ functions that complete on
+    other threads
+
+    Copyright (c) 2026 The Pybind Development Team.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include "pybind11.h"
+#include "detail/exception_translation.h"
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+/// Shared state of an awaitable<T>: the result once it is set, and the asyncio future (and its
+/// event loop) to resolve once a bound function returned the awaitable to Python. The Python
+/// objects are only touched with the GIL held.
+template <typename T>
+class awaitable_state {
+public:
+    using value_type = conditional_t<std::is_void<T>::value, void_type, T>;
+
+    awaitable_state() = default;
+    awaitable_state(const awaitable_state &) = delete;
+    awaitable_state &operator=(const awaitable_state &) = delete;
+
+    ~awaitable_state() {
+        if (future == nullptr || !interpreter_running()) {
+            return;
+        }
+        // Never completed: don't leave the awaiting coroutine hanging
+        gil_scoped_acquire acq;
+        auto exc = reinterpret_steal<object>(
+            PyObject_CallFunction(PyExc_RuntimeError,
+                                  "s",
+                                  "pybind11::awaitable destroyed without a result"));
+        resolve(false, std::move(exc));
+    }
+
+    template <typename... Ts>
+    void set_value(Ts &&...args) {
+        std::unique_lock<std::mutex> lock(mutex);
+        check_not_done();
+        value.reset(new value_type(std::forward<Ts>(args)...));
+        done = true;
+        resolve_if_attached(lock);
+    }
+
+    void set_exception(std::exception_ptr e) {
+        std::unique_lock<std::mutex> lock(mutex);
+        check_not_done();
+        exception = std::move(e);
+        done = true;
+        resolve_if_attached(lock);
+    }
+
+    bool is_done() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return done;
+    }
+
+    /// Creates the asyncio future on the running event loop, to be resolved when the result is
+    /// set. Requires the GIL.
+    object attach() {
+        object asyncio = module_::import("asyncio");
+        object loop_obj = asyncio.attr("get_running_loop")();
+        object fut = loop_obj.attr("create_future")();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (future != nullptr) {
+                pybind11_fail("pybind11::awaitable returned to Python more than once");
+            }
+            loop = loop_obj.release().ptr();
+            future = fut.inc_ref().ptr();
+            if (!done) {
+                return fut;
+            }
+        }
+        resolve_with_result();
+        return fut;
+    }
+
+private:
+    // The result may be set on a C++ thread during or after interpreter shutdown, when the GIL
+    // must not be acquired anymore. The future is then left unresolved.
+    static bool interpreter_running() {
+#if PY_VERSION_HEX >= 0x030D0000
+        return Py_IsInitialized() != 0 && Py_IsFinalizing() == 0;
+#else
+        return Py_IsInitialized() != 0 && _Py_IsFinalizing() == 0;
+#endif
+    }
+
+    void check_not_done() const {
+        if (done) {
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+    }
+
+    // Called with `lock` held after the result was set
+    void resolve_if_attached(std::unique_lock<std::mutex> &lock) {
+        if (future == nullptr) {
+            return;
+        }
+        lock.unlock();
+        if (!interpreter_running()) {
+            return;
+        }
+        gil_scoped_acquire acq;
+        resolve_with_result();
+    }
+
+    // Requires the GIL. Converts the result (or exception) to Python and resolves the future.
+    void resolve_with_result() {
+        object result;
+        bool ok = false;
+        try {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            result = reinterpret_steal<object>(
+                make_caster<value_type>::cast(std::move(*value), return_value_policy::move, {}));
+            if (!result) {
+                throw error_already_set();
+            }
+            ok = true;
+        } catch (error_already_set &e) {
+            result = e.value();
+        } catch (...) {
+            try_translate_exceptions();
+            result = error_already_set().value();
+        }
+        value.reset();
+        exception = nullptr;
+        resolve(ok, std::move(result));
+    }
+
+    // Requires the GIL. Schedules the future to be resolved on its event loop, which may be
+    // running on another thread, unless it was cancelled in the meantime.
+    void resolve(bool ok, object result) {
+        auto fut = reinterpret_steal<object>(future);
+        auto loop_obj = reinterpret_steal<object>(loop);
+        future = loop = nullptr;
+        cpp_function set_result([](const object &f, bool is_result, const object &r) {
+            if (f.attr("cancelled")().cast<bool>()) {
+                return;
+            }
+            f.attr(is_result ? "set_result" : "set_exception")(r);
+        });
+        try {
+            loop_obj.attr("call_soon_threadsafe")(set_result, fut, ok, result);
+        } catch (error_already_set &e) {
+            // E.g. the event loop was closed: nobody can await the future anymore
+            e.discard_as_unraisable(__func__);
+        }
+    }
+
+    mutable std::mutex mutex;
+    bool done = false;
+    std::unique_ptr<value_type> value;
+    std::exception_ptr exception;
+    PyObject *loop = nullptr;
+    PyObject *future = nullptr;
+};
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    The result of a computation that completes on a C++ thread. When returned from a bound
+    function, it is converted to an ``asyncio.Future`` of the running event loop, which is resolved
+    with the value passed to ``set_value()`` (or the exception passed to ``set_exception()``) via
+    ``call_soon_threadsafe()``. Copies refer to the same result.
+\endrst */
+template <typename T>
+class awaitable {
+public:
+    awaitable() : state(std::make_shared<detail::awaitable_state<T>>()) {}
+
+    /// Sets the result. Acquires the GIL if the awaitable was already returned to Python, unless
+    /// the interpreter is shutting down.
+    template <typename... Ts>
+    void set_value(Ts &&...args) const {
+        state->set_value(std::forward<Ts>(args)...);
+    }
+
+    /// Sets an exception, which is translated like exceptions thrown by bound functions
+    void set_exception(std::exception_ptr e) const { state->set_exception(std::move(e)); }
+
+    bool done() const { return state->is_done(); }
+
+private:
+    friend class detail::type_caster<awaitable<T>>;
+
+    std::shared_ptr<detail::awaitable_state<T>> state;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <typename T>
+class type_caster<awaitable<T>> {
+public:
+    static handle cast(const awaitable<T> &src, return_value_policy /* policy */, handle) {
+        return src.state->attach().release();
+    }
+
+    static constexpr auto name
+        = const_name("asyncio.Future[")
+          + make_caster<typename awaitable_state<T>::value_type>::name + const_name("]");
+};
+
+// Waits for a std::future on a separate thread and passes its result on to an awaitable
+template <typename T>
+struct future_waiter {
+    std::future<T> future;
+    awaitable<T> result;
+
+    void operator()() {
+        try {
+            complete(std::is_void<T>());
+        } catch (...) {
+            result.set_exception(std::current_exception());
+        }
+    }
+
+    void complete(std::false_type /* is_void */) { result.set_value(future.get()); }
+    void complete(std::true_type /* is_void */) {
+        future.get();
+        result.set_value();
+    }
+};
+
+/// std::future<T> is returned to Python as an asyncio.Future. Since std::future cannot notify
+/// anyone when it becomes ready, a detached OS thread is started for each one to wait for it,
+/// which exists until the future is ready. Return a py::awaitable<T> instead to avoid this.
+template <typename T>
+struct type_caster<std::future<T>> {
+    static handle cast(std::future<T> &&src, return_value_policy policy, handle parent) {
+        awaitable<T> result;
+        // The thread is started first, so that the std::future is never destroyed with the GIL
+        // held (which blocks for futures returned by std::async)
+        std::thread(future_waiter<T>{std::move(src), result}).detach();
+        return make_caster<awaitable<T>>::cast(result, policy, parent);
+    }
+
+    static constexpr auto name = make_caster<awaitable<T>>::name;
+};
+
+PYBIND11_NAMESPACE_END(detail)
+PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
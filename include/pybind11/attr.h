@@ -14,6 +14,8 @@
 #include "cast.h"
 #include "trampoline_self_life_support.h"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
@@ -86,6 +88,28 @@ struct buffer_protocol {};
 /// instances (pybind/pybind11#1446).
 struct release_gil_before_calling_cpp_dtor {};
 
+/// Annotation which disables instance tracking for a type: its instances are not added to the
+/// registry of live instances, and casting a C++ pointer or reference to the type always
+/// creates a new Python object instead of returning an existing one for the same address.
+/// Casting a raw pointer to the type with return_value_policy::take_ownership is an error.
+struct no_instance_tracking {};
+
+/// Annotation which stores the C++ object inside the Python object of each instance, instead of
+/// in a separate allocation, whenever pybind11 constructs it (requires the default holder)
+struct inline_value {};
+
+/// Annotation which makes PYBIND11_OVERRIDE skip the Python override of a virtual function while
+/// that same override is running for the same object on the current thread (e.g. when it calls
+/// the base implementation), instead of inspecting the calling Python frame to detect this.
+struct thread_local_override_guard {};
+
+/// Annotation which keeps the storage of up to `max_size` destroyed instances of a type to be
+/// reused by new instances of the same type, instead of returning it to the allocator
+struct freelist {
+    size_t max_size;
+    explicit freelist(size_t max_size = 256) : max_size(max_size) {}
+};
+
 /// Annotation which requests that a special metaclass is created for a type
 struct metaclass {
     handle value;
@@ -126,6 +150,35 @@ struct arithmetic {};
 /// Mark a function for addition at the beginning of the existing overload chain instead of the end
 struct prepend {};
 
+/// Annotation which enables an inline cache remembering, for a tuple of positional argument
+/// types, which overload of a function succeeded most recently; that overload is tried first on
+/// subsequent calls. Only use this if overload selection depends solely on the argument types
+/// (and not, e.g., on integer ranges). Applies to the whole overload set if given on any
+/// overload. Ignored on free-threaded Python builds.
+struct overload_cache {};
+
+/// Annotation for functions (e.g. lambdas with captures) which the std::function caster in
+/// 'functional.h' may call directly with their C++ arguments, bypassing the dispatcher and
+/// without holding the GIL, if the signatures match exactly. Only use it if the function's
+/// captured state doesn't hold Python objects. Cannot be used with methods, with a
+/// `py::call_guard` or with functions taking or returning Python objects.
+struct direct_call {};
+
+/// Annotation which releases the GIL while the C++ function runs, i.e. after the arguments were
+/// converted and before the result is converted to Python. Only functions given the annotation
+/// contain the code for it. It cannot be used with functions taking or returning Python objects
+/// (also inside containers, e.g. `std::vector<py::object>`), with constructors or with a
+/// `py::call_guard`. `release_gil_if_args_loaded(false)` keeps the GIL held.
+///
+/// Given as a `class_` template option (`py::class_<T, py::release_gil_if_args_loaded>`), it
+/// applies to the functions defined with `def()` and `def_static()`. For modules,
+/// `module_::release_gil_if_args_loaded()` returns a wrapper doing the same. In such scopes,
+/// functions which cannot release the GIL keep it.
+struct release_gil_if_args_loaded {
+    bool value;
+    explicit release_gil_if_args_loaded(bool value = true) : value(value) {}
+};
+
 /** \rst
     A call policy which places one or more guard variables (``Ts...``) around the function call.
 
@@ -186,19 +239,118 @@ struct argument_record {
     handle value;      ///< Associated Python object
     bool convert : 1;  ///< True if the argument is allowed to convert when loading
     bool none : 1;     ///< True if None is allowed when loading
+    handle name_str;   ///< Interned Python version of `name` (set by `cpp_function`), if any
 
     argument_record(const char *name, const char *descr, handle value, bool convert, bool none)
         : name(name), descr(descr), value(value), convert(convert), none(none) {}
 };
 
+/// Internal data structure which describes how the dispatcher fills a single argument slot of a
+/// function called without keyword arguments (see `function_record::call_plan`)
+struct call_plan_slot {
+    handle value;     ///< Default value (borrowed from the matching `argument_record`), if any
+    bool convert : 1; ///< True if the argument is allowed to convert when loading
+    bool none : 1;    ///< True if None is allowed when loading
+
+    call_plan_slot(handle value, bool convert, bool none)
+        : value(value), convert(convert), none(none) {}
+};
+
+/// Inline cache used by the dispatcher to remember which overload of a function succeeded without
+/// argument conversions for a tuple of positional argument types (see `overload_cache`)
+struct overload_type_cache {
+    static constexpr size_t max_args = 4;
+    static constexpr size_t num_entries = 4;
+
+    struct entry {
+        // Strong references, so that a deallocated type can't be mistaken for a new one
+        object types[max_args];
+        size_t nargs = 0;
+        const function_record *overload = nullptr;
+
+        bool matches(PyObject *const *args, size_t n) const {
+            if (overload == nullptr || nargs != n) {
+                return false;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (types[i].ptr() != reinterpret_cast<PyObject *>(Py_TYPE(args[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    entry entries[num_entries];
+    size_t next_entry = 0;
+
+    const entry *find(PyObject *const *args, size_t nargs) const {
+        for (const auto &e : entries) {
+            if (e.matches(args, nargs)) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(PyObject *const *args, size_t nargs, const function_record *overload) {
+        if (find(args, nargs) != nullptr) {
+            // The cached overload failed for these argument values, so selecting an overload
+            // depends on the values, not only on their types. Keep the entry rather than let
+            // the new overload shadow it for the values it accepts.
+            return;
+        }
+        // Round-robin replacement
+        entry &e = entries[next_entry];
+        next_entry = (next_entry + 1) % num_entries;
+        for (size_t i = 0; i < nargs; ++i) {
+            e.types[i]
+                = reinterpret_borrow<object>(reinterpret_cast<PyObject *>(Py_TYPE(args[i])));
+        }
+        for (size_t i = nargs; i < max_args; ++i) {
+            e.types[i] = object();
+        }
+        e.nargs = nargs;
+        e.overload = overload;
+    }
+};
+
+/// Durations of the calls of a function that released the GIL or could have released it (see
+/// py::enable_call_profiling()). Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds, the
+/// last bucket also all longer ones.
+struct call_duration_histogram {
+    static constexpr size_t num_buckets = 32;
+    std::atomic<std::uint64_t> buckets[num_buckets];
+
+    call_duration_histogram() {
+        for (auto &b : buckets) {
+            b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(std::uint64_t ns) {
+        size_t i = 0;
+        while (ns > 1 && i + 1 < num_buckets) {
+            ns >>= 1;
+            ++i;
+        }
+        buckets[i].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
 /// Internal data structure which holds metadata about a bound function (signature, overloads,
 /// etc.)
-#define PYBIND11_DETAIL_FUNCTION_RECORD_ABI_ID "v1" // PLEASE UPDATE if the struct is changed.
+#define PYBIND11_DETAIL_FUNCTION_RECORD_ABI_ID "v5" // PLEASE UPDATE if the struct is changed.
 struct function_record {
     function_record()
         : is_constructor(false), is_new_style_constructor(false), is_stateless(false),
           is_operator(false), is_method(false), is_setter(false), has_args(false),
-          has_kwargs(false), prepend(false) {}
+          has_kwargs(false), prepend(false), has_call_plan(false), use_overload_cache(false),
+          can_release_gil(false), release_gil(false) {}
+
+    function_record(const function_record &) = delete;
+    function_record &operator=(const function_record &) = delete;
+    ~function_record() { delete call_durations.load(std::memory_order_relaxed); }
 
     /// Function name
     char *name = nullptr; /* why no C++ strings? They generate heavier code.. */
@@ -221,6 +373,14 @@ struct function_record {
     /// Pointer to custom destructor for 'data' (if needed)
     void (*free_data)(function_record *ptr) = nullptr;
 
+    /// Type-erased `Return (*)(const function_record &, Args...)` which calls the wrapped
+    /// function directly with its C++ arguments, used by the std::function caster in
+    /// 'functional.h' to bypass the dispatcher (nullptr unless `py::direct_call()` was given)
+    void (*direct_call)() = nullptr;
+
+    /// `typeid(Return (*)(Args...))` for `direct_call`
+    const std::type_info *direct_call_type = nullptr;
+
     /// Return value policy associated with this function
     return_value_policy policy = return_value_policy::automatic;
 
@@ -251,6 +411,19 @@ struct function_record {
     /// True if this function is to be inserted at the beginning of the overload resolution chain
     bool prepend : 1;
 
+    /// True if `call_plan` can be used for calls without keyword arguments
+    bool has_call_plan : 1;
+
+    /// True if `py::overload_cache()` was specified for this function
+    bool use_overload_cache : 1;
+
+    /// True if the GIL could be released while the C++ function runs (no Python objects, no
+    /// call guard, not a constructor)
+    bool can_release_gil : 1;
+
+    /// True if the GIL is released while the C++ function runs (py::release_gil_if_args_loaded)
+    bool release_gil : 1;
+
     /// Number of arguments (including py::args and/or py::kwargs, if present)
     std::uint16_t nargs;
 
@@ -261,6 +434,20 @@ struct function_record {
     /// Number of leading arguments (counted in `nargs`) that are positional-only
     std::uint16_t nargs_pos_only = 0;
 
+    /// Minimum number of positional arguments for a `call_plan` match; the remaining slots are
+    /// filled from their default values
+    std::uint16_t call_plan_min_args = 0;
+
+    /// Precomputed slot map (one entry per argument) used by the dispatcher to fill
+    /// `function_call::args` without re-walking `args` on every call
+    std::vector<call_plan_slot> call_plan;
+
+    /// Overload resolution cache; only allocated on the first overload of a chain
+    std::unique_ptr<overload_type_cache> overload_cache;
+
+    /// Call durations recorded while call profiling is enabled (allocated on first use, owned)
+    std::atomic<call_duration_histogram *> call_durations{nullptr};
+
     /// Python method object
     PyMethodDef *def = nullptr;
 
@@ -284,7 +471,8 @@ struct function_record {
 struct type_record {
     PYBIND11_NOINLINE type_record()
         : multiple_inheritance(false), dynamic_attr(false), buffer_protocol(false),
-          module_local(false), is_final(false), release_gil_before_calling_cpp_dtor(false) {}
+          module_local(false), is_final(false), release_gil_before_calling_cpp_dtor(false),
+          no_instance_tracking(false), inline_value(false), thread_local_override_guard(false) {}
 
     /// Handle to the parent scope
     handle scope;
@@ -349,6 +537,22 @@ struct type_record {
     /// Solves pybind/pybind11#1446
     bool release_gil_before_calling_cpp_dtor : 1;
 
+    /// Are instances left out of the registry of live instances?
+    bool no_instance_tracking : 1;
+
+    /// Is the C++ object stored inside the Python object, if possible?
+    bool inline_value : 1;
+
+    /// Does PYBIND11_OVERRIDE detect recursion with a thread-local marker?
+    bool thread_local_override_guard : 1;
+
+    /// Maximum number of destroyed instances kept for reuse (0: no freelist)
+    size_t freelist_max_size = 0;
+
+    /// Copy/move constructors into inline value storage (py::inline_value), if available
+    void (*inline_copy_constructor)(void *, const void *) = nullptr;
+    void (*inline_move_constructor)(void *, const void *) = nullptr;
+
     holder_enum_t holder_enum_v = holder_enum_t::undefined;
 
     PYBIND11_NOINLINE void add_base(const std::type_info &base, void *(*caster)(void *) ) {
@@ -395,6 +599,11 @@ inline function_call::function_call(const function_record &f, handle p) : func(f
 /// Tag for a new-style `__init__` defined in `detail/init.h`
 struct is_new_style_constructor {};
 
+/// Added to the attributes of functions defined in a scope which opts into
+/// py::release_gil_if_args_loaded (if `Enabled`), see class_ and module_releasing_gil
+template <bool Enabled>
+struct release_gil_if_args_loaded_scope {};
+
 /**
  * Partial template specializations to process custom attributes provided to
  * cpp_function_ and class_. These are either used to initialize the respective
@@ -635,12 +844,65 @@ struct process_attribute<release_gil_before_calling_cpp_dtor>
     }
 };
 
+template <>
+struct process_attribute<inline_value> : process_attribute_default<inline_value> {
+    static void init(const inline_value &, type_record *r) { r->inline_value = true; }
+};
+
+template <>
+struct process_attribute<freelist> : process_attribute_default<freelist> {
+    static void init(const freelist &f, type_record *r) { r->freelist_max_size = f.max_size; }
+};
+
+template <>
+struct process_attribute<no_instance_tracking> : process_attribute_default<no_instance_tracking> {
+    static void init(const no_instance_tracking &, type_record *r) {
+        r->no_instance_tracking = true;
+    }
+};
+
+template <>
+struct process_attribute<thread_local_override_guard>
+    : process_attribute_default<thread_local_override_guard> {
+    static void init(const thread_local_override_guard &, type_record *r) {
+        r->thread_local_override_guard = true;
+    }
+};
+
 /// Process a 'prepend' attribute, putting this at the beginning of the overload chain
 template <>
 struct process_attribute<prepend> : process_attribute_default<prepend> {
     static void init(const prepend &, function_record *r) { r->prepend = true; }
 };
 
+/// Process a 'direct_call' attribute (handled in cpp_function::initialize)
+template <>
+struct process_attribute<direct_call> : process_attribute_default<direct_call> {};
+
+/// Process an 'overload_cache' attribute, enabling the overload resolution cache
+template <>
+struct process_attribute<overload_cache> : process_attribute_default<overload_cache> {
+    static void init(const overload_cache &, function_record *r) { r->use_overload_cache = true; }
+};
+
+/// Process a 'release_gil_if_args_loaded' attribute
+template <>
+struct process_attribute<release_gil_if_args_loaded>
+    : process_attribute_default<release_gil_if_args_loaded> {
+    static void init(const release_gil_if_args_loaded &r, function_record *rec) {
+        rec->release_gil = r.value;
+    }
+    // Whether a function can release the GIL is decided when it is compiled: classes opt in
+    // with a class_ template option, py::class_<T, py::release_gil_if_args_loaded>
+    static void init(const release_gil_if_args_loaded &, type_record *) = delete;
+};
+
+/// Process the attribute added by scopes opting into release_gil_if_args_loaded (handled in
+/// cpp_function::initialize)
+template <bool Enabled>
+struct process_attribute<release_gil_if_args_loaded_scope<Enabled>>
+    : process_attribute_default<release_gil_if_args_loaded_scope<Enabled>> {};
+
 /// Process an 'arithmetic' attribute for enums (does nothing here)
 template <>
 struct process_attribute<arithmetic> : process_attribute_default<arithmetic> {};
@@ -19,7 +19,9 @@
 #include "detail/typeid.h"
 #include "pytypes.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstring>
 #include <functional>
 #include <iosfwd>
@@ -355,6 +357,83 @@ public:
                                             "float"));
 };
 
+// Numbers loaded by the arithmetic `type_caster` above (i.e. not `bool` and not character types,
+// which are loaded from `str`). Containers of them can be filled directly from buffers with a
+// matching format (see `matching_1d_buffer`) without changing which inputs are accepted.
+template <typename T>
+using is_bulk_copyable = bool_constant<std::is_arithmetic<T>::value
+                                       && !std::is_same<T, bool>::value
+                                       && !is_std_char_type<T>::value>;
+
+// A one-dimensional, possibly strided buffer of `T`s exported by a Python object (e.g. an
+// `array.array`, a `memoryview` or a NumPy array), whose items can be copied directly. Unlike
+// buffer::request(), this evaluates to false (without setting an error) if `src` doesn't export
+// such a buffer, so that callers can fall back to converting the items one by one.
+template <typename T>
+class matching_1d_buffer {
+public:
+    explicit matching_1d_buffer(handle src) {
+        if (PyObject_CheckBuffer(src.ptr()) == 0) {
+            return;
+        }
+        if (PyObject_GetBuffer(src.ptr(), &view, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+            PyErr_Clear();
+            return;
+        }
+        exported = true;
+        matches = view.ndim == 1 && format_matches(format(), view.itemsize)
+                  && view.strides[0] % view.itemsize == 0;
+    }
+    matching_1d_buffer(const matching_1d_buffer &) = delete;
+    matching_1d_buffer &operator=(const matching_1d_buffer &) = delete;
+    ~matching_1d_buffer() {
+        if (exported) {
+            PyBuffer_Release(&view);
+        }
+    }
+
+    explicit operator bool() const { return matches; }
+    /// Number of dimensions of the exported buffer (0 if there is none)
+    ssize_t ndim() const { return exported ? view.ndim : 0; }
+    const char *format() const { return view.format != nullptr ? view.format : "B"; }
+    size_t size() const { return static_cast<size_t>(view.shape[0]); }
+    bool contiguous() const { return view.strides[0] == view.itemsize; }
+    const T *data() const { return static_cast<const T *>(view.buf); }
+    const T &operator[](size_t i) const {
+        return data()[static_cast<ssize_t>(i) * (view.strides[0] / view.itemsize)];
+    }
+
+    /// Copies the items to `out` and returns the end of the copied range
+    template <typename OutputIt>
+    OutputIt copy_to(OutputIt out) const {
+        if (contiguous()) {
+            return std::copy(data(), data() + size(), out);
+        }
+        for (size_t i = 0; i < size(); ++i, ++out) {
+            *out = (*this)[i];
+        }
+        return out;
+    }
+
+    /// Like compare_buffer_info, but also accepts an explicit native byte order
+    static bool format_matches(const char *format, ssize_t itemsize) {
+        std::string fmt = format;
+        // "=" also implies standard sizes, which the comparison of the item size covers
+        const std::uint16_t one = 1;
+        const char native_order = *reinterpret_cast<const char *>(&one) == 1 ? '<' : '>';
+        if (fmt.size() == 2 && (fmt[0] == '@' || fmt[0] == '=' || fmt[0] == native_order)) {
+            fmt.erase(0, 1);
+        }
+        return compare_buffer_info<T>::compare(
+            buffer_info(nullptr, itemsize, fmt, 0, std::vector<ssize_t>(), std::vector<ssize_t>()));
+    }
+
+private:
+    Py_buffer view{};
+    bool exported = false;
+    bool matches = false;
+};
+
 template <typename T>
 struct void_caster {
 public:
@@ -484,6 +563,133 @@ private:
     }
 };
 
+// Common base of py::bytes_view and py::str_view
+class char_buffer_view {
+public:
+    char_buffer_view() = default;
+    char_buffer_view(const char *data, size_t size) : data_(data), size_(size) {}
+
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const char *begin() const { return data_; }
+    const char *end() const { return data_ + size_; }
+    char operator[](size_t i) const { return data_[i]; }
+
+    explicit operator std::string() const { return std::string(data_, size_); }
+#ifdef PYBIND11_HAS_STRING_VIEW
+    operator std::string_view() const { return std::string_view(data_, size_); }
+#endif
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    A read-only view of the bytes of a function argument, which can be a ``bytes``, a
+    ``bytearray`` or any other object exporting a C-contiguous buffer. It points into the memory of
+    the object instead of copying it. The object is kept alive (and buffers stay exported, which
+    e.g. prevents resizing a ``bytearray``) until the bound function returns, so the view must not
+    be used after that.
+\endrst */
+class bytes_view : public detail::char_buffer_view {
+public:
+    using char_buffer_view::char_buffer_view;
+};
+
+/** \rst
+    Like :class:`bytes_view`, but also accepts a ``str``, viewing its UTF-8 representation (which
+    Python caches in the ``str`` object).
+\endrst */
+class str_view : public detail::char_buffer_view {
+public:
+    using char_buffer_view::char_buffer_view;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <typename View>
+struct char_buffer_view_name {
+    static constexpr auto name = io_name(PYBIND11_BUFFER_TYPE_HINT, PYBIND11_BYTES_NAME);
+};
+template <>
+struct char_buffer_view_name<str_view> {
+    static constexpr auto name = const_name(PYBIND11_STRING_NAME);
+};
+
+// Loads a bytes_view or str_view without copying the underlying memory
+template <typename View>
+struct char_buffer_view_caster {
+    static handle cast(const View &src, return_value_policy /* policy */, handle /* parent */) {
+        handle result = std::is_same<View, str_view>::value
+                            ? PyUnicode_DecodeUTF8(src.data(), ssize_t_cast(src.size()), nullptr)
+                            : PYBIND11_BYTES_FROM_STRING_AND_SIZE(src.data(),
+                                                                  ssize_t_cast(src.size()));
+        if (!result) {
+            throw error_already_set();
+        }
+        return result;
+    }
+
+    PYBIND11_TYPE_CASTER(View, char_buffer_view_name<View>::name);
+
+protected:
+    bool load_bytes_like(handle src) {
+        if (PYBIND11_BYTES_CHECK(src.ptr())) {
+            // Immutable, so keeping the object alive is enough
+            value = View(PYBIND11_BYTES_AS_STRING(src.ptr()),
+                         static_cast<size_t>(PYBIND11_BYTES_SIZE(src.ptr())));
+            loader_life_support::try_add_patient(src);
+            return true;
+        }
+        if (!PyObject_CheckBuffer(src.ptr())) {
+            return false;
+        }
+        // The memoryview holds on to the exported buffer until the call returns
+        auto view = reinterpret_steal<object>(PyMemoryView_FromObject(src.ptr()));
+        if (!view) {
+            PyErr_Clear();
+            return false;
+        }
+        const Py_buffer *buf = PyMemoryView_GET_BUFFER(view.ptr());
+        if (PyBuffer_IsContiguous(buf, 'C') == 0) {
+            return false;
+        }
+        loader_life_support::add_patient(view);
+        value = View(static_cast<const char *>(buf->buf), static_cast<size_t>(buf->len));
+        return true;
+    }
+};
+
+template <>
+struct type_caster<bytes_view> : char_buffer_view_caster<bytes_view> {
+    bool load(handle src, bool) { return src && load_bytes_like(src); }
+};
+
+template <>
+struct type_caster<str_view> : char_buffer_view_caster<str_view> {
+    bool load(handle src, bool) {
+        if (!src) {
+            return false;
+        }
+        if (!PyUnicode_Check(src.ptr())) {
+            return load_bytes_like(src);
+        }
+        Py_ssize_t size = -1;
+        const char *buffer = PyUnicode_AsUTF8AndSize(src.ptr(), &size);
+        if (!buffer) {
+            PyErr_Clear();
+            return false;
+        }
+        value = str_view(buffer, static_cast<size_t>(size));
+        loader_life_support::try_add_patient(src);
+        return true;
+    }
+};
+
 // Helper class for UTF-{8,16,32} C++ stl strings:
 template <typename StringType, bool IsView = false>
 struct string_caster {
@@ -756,6 +962,37 @@ public:
     using cast_op_type = pybind11::detail::cast_op_type<_T>;
 };
 
+// Direct element access for exact `list` and `tuple` objects, bypassing the iterator protocol
+// and `PySequence_GetItem`. Subclasses are excluded since they may override item access.
+inline bool is_exact_list_or_tuple(handle src) {
+    return PyList_CheckExact(src.ptr()) || PyTuple_CheckExact(src.ptr());
+}
+
+inline ssize_t list_or_tuple_size(handle seq) {
+    return PyTuple_CheckExact(seq.ptr()) ? PyTuple_GET_SIZE(seq.ptr())
+                                         : PyList_GET_SIZE(seq.ptr());
+}
+
+// Returns a null object if the index is out of range, which can happen for lists that are
+// resized while their elements are being converted.
+inline object list_or_tuple_item(handle seq, ssize_t index) {
+    if (PyTuple_CheckExact(seq.ptr())) {
+        return reinterpret_borrow<object>(PyTuple_GET_ITEM(seq.ptr(), index));
+    }
+#ifdef Py_GIL_DISABLED
+    auto item = reinterpret_steal<object>(PyList_GetItemRef(seq.ptr(), index));
+    if (!item) {
+        PyErr_Clear();
+    }
+    return item;
+#else
+    if (index >= PyList_GET_SIZE(seq.ptr())) {
+        return object();
+    }
+    return reinterpret_borrow<object>(PyList_GET_ITEM(seq.ptr(), index));
+#endif
+}
+
 // Base implementation for std::tuple and std::pair
 template <template <typename...> class Tuple, typename... Ts>
 class tuple_caster {
@@ -768,6 +1005,12 @@ public:
         if (!isinstance<sequence>(src)) {
             return false;
         }
+        if (is_exact_list_or_tuple(src)) {
+            if (list_or_tuple_size(src) != static_cast<ssize_t>(size)) {
+                return false;
+            }
+            return load_items(src, convert, indices{});
+        }
         const auto seq = reinterpret_borrow<sequence>(src);
         if (seq.size() != size) {
             return false;
@@ -814,10 +1057,28 @@ protected:
         return type(cast_op<Ts>(std::move(std::get<Is>(subcasters)))...);
     }
 
-    static constexpr bool load_impl(const sequence &, bool, index_sequence<>) { return true; }
+    static bool load_items(handle, bool, index_sequence<>) { return true; }
 
+    // All items are referenced up front: converting one of them may run Python code that
+    // modifies a list.
     template <size_t... Is>
-    bool load_impl(const sequence &seq, bool convert, index_sequence<Is...>) {
+    bool load_items(handle src, bool convert, index_sequence<Is...>) {
+        std::array<object, size> items{{list_or_tuple_item(src, static_cast<ssize_t>(Is))...}};
+        for (const auto &item : items) {
+            if (!item) {
+                return false;
+            }
+        }
+        return load_impl(items, convert, indices{});
+    }
+
+    template <typename Seq>
+    static constexpr bool load_impl(const Seq &, bool, index_sequence<>) {
+        return true;
+    }
+
+    template <typename Seq, size_t... Is>
+    bool load_impl(const Seq &seq, bool convert, index_sequence<Is...>) {
 #ifdef __cpp_fold_expressions
         if ((... || !std::get<Is>(subcasters).load(seq[Is], convert))) {
             return false;
@@ -1631,12 +1892,28 @@ using cast_is_temporary_value_reference
                     && !std::is_base_of<type_caster_generic, make_caster<type>>::value
                     && !std::is_same<intrinsic_t<type>, void>::value>;
 
+// Casters which implement `return_value_policy::lazy_sequence` declare a static constexpr
+// `supports_lazy_sequence` member set to true.
+template <typename Caster, typename SFINAE = void>
+struct supports_lazy_sequence : std::false_type {};
+
+template <typename Caster>
+struct supports_lazy_sequence<Caster, enable_if_t<Caster::supports_lazy_sequence>>
+    : std::true_type {};
+
 // When a value returned from a C++ function is being cast back to Python, we almost always want to
 // force `policy = move`, regardless of the return value policy the function/method was declared
-// with.
+// with. `return_value_policy::lazy_sequence` falls back to `automatic` for pointers and for types
+// which don't support it.
 template <typename Return, typename SFINAE = void>
 struct return_value_policy_override {
-    static return_value_policy policy(return_value_policy p) { return p; }
+    static return_value_policy policy(return_value_policy p) {
+        return p == return_value_policy::lazy_sequence
+                       && (std::is_pointer<Return>::value
+                           || !supports_lazy_sequence<make_caster<Return>>::value)
+                   ? return_value_policy::automatic
+                   : p;
+    }
 };
 
 template <typename Return>
@@ -1644,9 +1921,10 @@ struct return_value_policy_override<
     Return,
     detail::enable_if_t<std::is_base_of<type_caster_generic, make_caster<Return>>::value, void>> {
     static return_value_policy policy(return_value_policy p) {
-        return !std::is_lvalue_reference<Return>::value && !std::is_pointer<Return>::value
-                   ? return_value_policy::move
-                   : p;
+        if (!std::is_lvalue_reference<Return>::value && !std::is_pointer<Return>::value) {
+            return return_value_policy::move;
+        }
+        return p == return_value_policy::lazy_sequence ? return_value_policy::automatic : p;
     }
 };
 
@@ -1739,6 +2017,9 @@ object cast(T &&value,
             return_value_policy policy = return_value_policy::automatic_reference,
             handle parent = handle()) {
     using no_ref_T = typename std::remove_reference<T>::type;
+    if (policy == return_value_policy::lazy_sequence) {
+        policy = detail::return_value_policy_override<T>::policy(policy);
+    }
     if (policy == return_value_policy::automatic) {
         policy = std::is_pointer<no_ref_T>::value     ? return_value_policy::take_ownership
                  : std::is_lvalue_reference<T>::value ? return_value_policy::copy
@@ -2162,17 +2443,20 @@ public:
 
     bool load_args(function_call &call) { return load_impl_sequence(call, indices{}); }
 
-    template <typename Return, typename Guard, typename Func>
+    // `guard_args` are passed on to the constructor of the guard
+    template <typename Return, typename Guard, typename Func, typename... GuardArgs>
     // NOLINTNEXTLINE(readability-const-return-type)
-    enable_if_t<!std::is_void<Return>::value, Return> call(Func &&f) && {
+    enable_if_t<!std::is_void<Return>::value, Return> call(Func &&f,
+                                                           GuardArgs &&...guard_args) && {
         return std::move(*this).template call_impl<remove_cv_t<Return>>(
-            std::forward<Func>(f), indices{}, Guard{});
+            std::forward<Func>(f), indices{}, Guard{std::forward<GuardArgs>(guard_args)...});
     }
 
-    template <typename Return, typename Guard, typename Func>
-    enable_if_t<std::is_void<Return>::value, void_type> call(Func &&f) && {
+    template <typename Return, typename Guard, typename Func, typename... GuardArgs>
+    enable_if_t<std::is_void<Return>::value, void_type> call(Func &&f,
+                                                             GuardArgs &&...guard_args) && {
         std::move(*this).template call_impl<remove_cv_t<Return>>(
-            std::forward<Func>(f), indices{}, Guard{});
+            std::forward<Func>(f), indices{}, Guard{std::forward<GuardArgs>(guard_args)...});
         return void_type();
     }
 
@@ -2218,6 +2502,11 @@ constexpr bool args_has_keyword_or_ds() {
     return any_of<is_keyword_or_ds<Args>...>::value;
 }
 
+template <typename... Args>
+constexpr bool args_are_all_positional() {
+    return all_of<is_positional<Args>...>::value;
+}
+
 /// Helper class which collects positional, keyword, * and ** arguments for a Python function call
 template <return_value_policy policy>
 class unpacking_collector {
@@ -2409,6 +2698,52 @@ unpacking_collector<policy> collect_arguments(Args &&...args) {
     return unpacking_collector<policy>(std::forward<Args>(args)...);
 }
 
+// Converts the `index`-th argument of a Python function call
+template <return_value_policy policy, typename T>
+object cast_call_arg(T &&x, size_t index) {
+    handle h = detail::make_caster<T>::cast(std::forward<T>(x), policy, {});
+    if (!h) {
+#if !defined(PYBIND11_DETAILED_ERROR_MESSAGES)
+        throw cast_error_unable_to_convert_call_arg(std::to_string(index));
+#else
+        throw cast_error_unable_to_convert_call_arg(std::to_string(index), type_id<T>());
+#endif
+    }
+    return reinterpret_steal<object>(h); // cast returns a new reference
+}
+
+/// Calls a Python function with positional arguments only. Unlike unpacking_collector, the number
+/// of arguments is known at compile time, so they are converted straight into an array on the
+/// stack which is passed to vectorcall as is.
+template <return_value_policy policy, typename... Args, size_t... Is>
+object call_positional(PyObject *ptr, index_sequence<Is...>, Args &&...args) {
+    // The first element is the extra space for PY_VECTORCALL_ARGUMENTS_OFFSET (see
+    // unpacking_collector)
+    object objects[] = {object(), cast_call_arg<policy>(std::forward<Args>(args), Is)...};
+    PyObject *argv[] = {nullptr, objects[Is + 1].ptr()...};
+    PyObject *result = PyObject_Vectorcall(
+        ptr, argv + 1, sizeof...(Args) | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+    if (!result) {
+        throw error_already_set();
+    }
+    return reinterpret_steal<object>(result);
+}
+
+template <return_value_policy policy, typename... Args>
+object call_with_arguments(std::true_type /* all_positional */,
+                           PyObject *ptr,
+                           Args &&...args) {
+    return call_positional<policy>(
+        ptr, make_index_sequence<sizeof...(Args)>(), std::forward<Args>(args)...);
+}
+
+template <return_value_policy policy, typename... Args>
+object call_with_arguments(std::false_type /* all_positional */,
+                           PyObject *ptr,
+                           Args &&...args) {
+    return collect_arguments<policy>(std::forward<Args>(args)...).call(ptr);
+}
+
 template <typename Derived>
 template <return_value_policy policy, typename... Args>
 object object_api<Derived>::operator()(Args &&...args) const {
@@ -2417,7 +2752,10 @@ object object_api<Derived>::operator()(Args &&...args) const {
         pybind11_fail("pybind11::object_api<>::operator() PyGILState_Check() failure.");
     }
 #endif
-    return detail::collect_arguments<policy>(std::forward<Args>(args)...).call(derived().ptr());
+    return detail::call_with_arguments<policy>(
+        bool_constant<detail::args_are_all_positional<Args...>()>(),
+        derived().ptr(),
+        std::forward<Args>(args)...);
 }
 
 template <typename Derived>
@@ -205,6 +205,26 @@ extern "C" inline PyObject *pybind11_meta_call(PyObject *type, PyObject *args, P
     return self;
 }
 
+/// Drops the cached override lookups of a type that is being deallocated.
+inline void erase_override_caches(internals &internals, const PyObject *type) {
+    // Actually just `std::erase_if`, but that's only available in C++20
+    auto &cache = internals.inactive_override_cache;
+    for (auto it = cache.begin(), last = cache.end(); it != last;) {
+        if (it->first == type) {
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#if PYBIND11_INTERNALS_VERSION >= 13
+    auto table = internals.override_tables.find(type);
+    if (table != internals.override_tables.end()) {
+        table->second.clear();
+        internals.override_tables.erase(table);
+    }
+#endif
+}
+
 /// Cleanup the type-info for a pybind11-registered type.
 extern "C" inline void pybind11_meta_dealloc(PyObject *obj) {
     with_internals_if_internals([obj](internals &internals) {
@@ -224,6 +244,9 @@ extern "C" inline void pybind11_meta_dealloc(PyObject *obj) {
             auto &local_internals = get_local_internals();
             if (tinfo->module_local) {
                 local_internals.registered_types_cpp.erase(tinfo->cpptype);
+#ifdef Py_GIL_DISABLED
+                local_internals.registered_types_cpp_lock_free.deregister_type(tinfo);
+#endif
             } else {
                 internals.registered_types_cpp.erase(tindex);
 #if PYBIND11_INTERNALS_VERSION >= 12
@@ -233,19 +256,26 @@ extern "C" inline void pybind11_meta_dealloc(PyObject *obj) {
                     (void) num_erased;
                     assert(num_erased > 0);
                 }
+#endif
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+                internals.registered_types_cpp_lock_free.deregister_type(tinfo);
 #endif
             }
             internals.registered_types_py.erase(tinfo->type);
+#if PYBIND11_INTERNALS_VERSION >= 13
+            internals.type_registry_generation.fetch_add(1, std::memory_order_release);
+#endif
+
+            erase_override_caches(internals, (PyObject *) tinfo->type);
 
-            // Actually just `std::erase_if`, but that's only available in C++20
-            auto &cache = internals.inactive_override_cache;
-            for (auto it = cache.begin(), last = cache.end(); it != last;) {
-                if (it->first == (PyObject *) tinfo->type) {
-                    it = cache.erase(it);
-                } else {
-                    ++it;
+#if PYBIND11_INTERNALS_VERSION >= 13
+            if (tinfo->freelist) {
+                for (PyObject *recycled : tinfo->freelist->objects) {
+                    reinterpret_cast<instance *>(recycled)->deallocate_layout();
+                    type->tp_free(recycled);
                 }
             }
+#endif
 
             delete tinfo;
         }
@@ -367,6 +397,11 @@ inline bool deregister_instance_impl(void *ptr, instance *self) {
 }
 
 inline void register_instance(instance *self, void *valptr, const type_info *tinfo) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (tinfo->no_instance_tracking) {
+        return;
+    }
+#endif
     register_instance_impl(valptr, self);
     if (!tinfo->simple_ancestors) {
         traverse_offset_bases(valptr, tinfo, self, register_instance_impl);
@@ -374,6 +409,11 @@ inline void register_instance(instance *self, void *valptr, const type_info *tin
 }
 
 inline bool deregister_instance(instance *self, void *valptr, const type_info *tinfo) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (tinfo->no_instance_tracking) {
+        return true;
+    }
+#endif
     bool ret = deregister_instance_impl(valptr, self);
     if (!tinfo->simple_ancestors) {
         traverse_offset_bases(valptr, tinfo, self, deregister_instance_impl);
@@ -381,6 +421,27 @@ inline bool deregister_instance(instance *self, void *valptr, const type_info *t
     return ret;
 }
 
+#if PYBIND11_INTERNALS_VERSION >= 13
+/// Returns the freelist holding recycled storage for instances of `type`, if any. Instances of
+/// Python subclasses of a bound type never use its freelist, as their storage is laid out
+/// differently.
+inline instance_freelist *get_instance_freelist(PyTypeObject *type,
+                                                const std::vector<type_info *> &tinfo) {
+    return tinfo.size() == 1 && tinfo.front()->type == type ? tinfo.front()->freelist.get()
+                                                             : nullptr;
+}
+
+/// Instance freelists only handle plain object storage, without GC header or managed dict
+inline bool instance_freelist_supported(PyTypeObject *type) {
+#    ifdef PYBIND11_HAS_INSTANCE_FREELIST
+    return !PyType_HasFeature(type, Py_TPFLAGS_HAVE_GC) && type->tp_itemsize == 0;
+#    else
+    (void) type;
+    return false;
+#    endif
+}
+#endif
+
 /// Instance creation function for all pybind11 types. It allocates the internal instance layout
 /// for holding C++ objects and holders.  Allocation is done lazily (the first time the instance is
 /// cast to a reference or pointer), and initialization is done by an `__init__` function.
@@ -393,10 +454,33 @@ inline PyObject *make_new_instance(PyTypeObject *type) {
         type->tp_basicsize = instance_size;
     }
 #endif
-    PyObject *self = type->tp_alloc(type, 0);
+    const auto &tinfo = all_type_info(type);
+    PyObject *self = nullptr;
+#ifdef PYBIND11_HAS_INSTANCE_FREELIST
+    if (instance_freelist *freelist = get_instance_freelist(type, tinfo)) {
+        auto &stats = get_internals().freelist_stats;
+        if (freelist->objects.empty()) {
+            ++stats.allocated;
+        } else {
+            self = freelist->objects.back();
+            freelist->objects.pop_back();
+            ++stats.reused;
+            // Same initialization as tp_alloc(), except that the value/holder block is kept
+            auto *inst = reinterpret_cast<instance *>(self);
+            void **values_and_holders
+                = inst->simple_layout ? nullptr : inst->nonsimple.values_and_holders;
+            std::memset(static_cast<void *>(self), 0, static_cast<size_t>(type->tp_basicsize));
+            PyObject_Init(self, type);
+            inst->nonsimple.values_and_holders = values_and_holders;
+        }
+    }
+#endif
+    if (self == nullptr) {
+        self = type->tp_alloc(type, 0);
+    }
     auto *inst = reinterpret_cast<instance *>(self);
     // Allocate the value/holder internals:
-    inst->allocate_layout();
+    inst->allocate_layout(tinfo);
 
     return self;
 }
@@ -451,12 +535,15 @@ inline void clear_patients(PyObject *self) {
 }
 
 /// Clears all internal data from the instance and removes it from registered instances in
-/// preparation for deallocation.
-inline void clear_instance(PyObject *self) {
+/// preparation for deallocation. `tinfo` are the pybind11 base types of the instance. With
+/// `keep_layout`, the value/holder block is not freed, so that it can be reused along with the
+/// instance storage (see instance_freelist).
+inline void
+clear_instance(PyObject *self, const std::vector<type_info *> &tinfo, bool keep_layout = false) {
     auto *instance = reinterpret_cast<detail::instance *>(self);
 
     // Deallocate any values/holders, if present:
-    for (auto &v_h : values_and_holders(instance)) {
+    for (auto &v_h : values_and_holders(instance, tinfo)) {
         if (v_h) {
 
             // We have to deregister before we call dealloc because, for virtual MI types, we still
@@ -475,7 +562,9 @@ inline void clear_instance(PyObject *self) {
         }
     }
     // Deallocate the value/holder layout internals:
-    instance->deallocate_layout();
+    if (!keep_layout) {
+        instance->deallocate_layout();
+    }
 
     if (instance->weakrefs) {
         PyObject_ClearWeakRefs(self);
@@ -514,7 +603,24 @@ extern "C" inline void pybind11_object_dealloc(PyObject *self) {
     }
 #endif
 
-    clear_instance(self);
+    const auto &tinfo = all_type_info(type);
+#ifdef PYBIND11_HAS_INSTANCE_FREELIST
+    instance_freelist *freelist = get_instance_freelist(type, tinfo);
+    clear_instance(self, tinfo, /*keep_layout=*/freelist != nullptr);
+    if (freelist != nullptr) {
+        auto &stats = get_internals().freelist_stats;
+        if (freelist->objects.size() < freelist->max_size) {
+            freelist->objects.push_back(self);
+            ++stats.recycled;
+            Py_DECREF(type);
+            return;
+        }
+        ++stats.released;
+        reinterpret_cast<instance *>(self)->deallocate_layout();
+    }
+#else
+    clear_instance(self, tinfo);
+#endif
 
     type->tp_free(self);
 
@@ -735,6 +841,35 @@ inline void enable_buffer_protocol(PyHeapTypeObject *heap_type) {
     heap_type->as_buffer.bf_releasebuffer = pybind11_releasebuffer;
 }
 
+#if PYBIND11_INTERNALS_VERSION >= 13
+/// Size of the instances of a new type before its own inline value storage, if any: C++
+/// subclasses keep the inline value storage of their bases (py::inline_value).
+inline size_t instance_base_size(const type_record &rec) {
+    size_t size = sizeof(instance);
+    for (handle base : rec.bases) {
+        auto *base_info = get_type_info(reinterpret_cast<PyTypeObject *>(base.ptr()));
+        if (base_info != nullptr && base_info->inline_value_offset != 0
+            && base_info->inline_value_offset + base_info->type_size > size) {
+            size = base_info->inline_value_offset + base_info->type_size;
+        }
+    }
+    return size;
+}
+
+/// Offset of the value storage inside the instances of a type bound with py::inline_value, or 0
+/// if its values are allocated separately. Python objects are only aligned to twice the size of
+/// a pointer, so more strictly aligned types cannot be stored inline.
+inline size_t inline_value_offset(const type_record &rec) {
+#    if !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+    if (rec.inline_value && rec.type_align <= 2 * sizeof(void *)) {
+        size_t size = instance_base_size(rec);
+        return (size + rec.type_align - 1) / rec.type_align * rec.type_align;
+    }
+#    endif
+    return 0;
+}
+#endif
+
 /** Create a brand new Python type according to the `type_record` specification.
     Return value: New reference. */
 inline PyObject *make_new_python_type(const type_record &rec) {
@@ -753,6 +888,15 @@ inline PyObject *make_new_python_type(const type_record &rec) {
 #endif
                 rec.name);
 
+    auto basicsize = static_cast<ssize_t>(sizeof(instance));
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (size_t offset = inline_value_offset(rec)) {
+        basicsize = static_cast<ssize_t>(offset + rec.type_size);
+    } else {
+        basicsize = static_cast<ssize_t>(instance_base_size(rec));
+    }
+#endif
+
     char *tp_doc = nullptr;
     if (rec.doc && options::show_user_defined_docstrings()) {
         /* Allocate memory for docstring (Python will free this later on) */
@@ -790,7 +934,7 @@ inline PyObject *make_new_python_type(const type_record &rec) {
     type->tp_name = full_name;
     type->tp_doc = tp_doc;
     type->tp_base = type_incref(reinterpret_cast<PyTypeObject *>(base));
-    type->tp_basicsize = static_cast<ssize_t>(sizeof(instance));
+    type->tp_basicsize = basicsize;
     if (!bases.empty()) {
         type->tp_bases = bases.release().ptr();
     }
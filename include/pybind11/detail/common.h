@@ -601,7 +601,16 @@ enum class return_value_policy : uint8_t {
         collected while Python is still using the child. More advanced
         variations of this scheme are also possible using combinations of
         return_value_policy::reference and the keep_alive call policy */
-    reference_internal
+    reference_internal,
+
+    /** This policy only applies to ``std::vector`` return values (requires
+        pybind11/stl.h). Instead of converting all elements into a Python list
+        up front, the vector is moved (or copied, for lvalue references) into a
+        read-only Python sequence that converts elements only when they are
+        accessed, and that exposes the buffer protocol for arithmetic element
+        types. Any other return value, including pointers to vectors, is handled
+        as with return_value_policy::automatic. */
+    lazy_sequence
 };
 
 PYBIND11_NAMESPACE_BEGIN(detail)
@@ -680,6 +689,8 @@ struct instance {
     /// Initializes all of the above type/values/holders data (but not the instance values
     /// themselves)
     void allocate_layout();
+    /// Same as above, given the pybind11 base types of the instance (i.e. `all_type_info()`)
+    void allocate_layout(const std::vector<type_info *> &tinfo);
 
     /// Destroys/deallocates all of the above
     void deallocate_layout();
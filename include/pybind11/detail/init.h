@@ -83,6 +83,27 @@ inline Class *construct_or_initialize(Args &&...args) {
     return new Class{std::forward<Args>(args)...};
 }
 
+// Same as construct_or_initialize, but constructs the object in `storage` unless it is nullptr
+// (used for the inline value storage of py::inline_value types)
+template <typename Class,
+          typename... Args,
+          detail::enable_if_t<std::is_constructible<Class, Args...>::value, int> = 0>
+inline Class *construct_or_initialize_at(void *storage, Args &&...args) {
+    if (storage != nullptr) {
+        return ::new (storage) Class(std::forward<Args>(args)...);
+    }
+    return new Class(std::forward<Args>(args)...);
+}
+template <typename Class,
+          typename... Args,
+          detail::enable_if_t<!std::is_constructible<Class, Args...>::value, int> = 0>
+inline Class *construct_or_initialize_at(void *storage, Args &&...args) {
+    if (storage != nullptr) {
+        return ::new (storage) Class{std::forward<Args>(args)...};
+    }
+    return new Class{std::forward<Args>(args)...};
+}
+
 // Attempts to constructs an alias using a `Alias(Cpp &&)` constructor.  This allows types with
 // an alias to provide only a single Cpp factory function as long as the Alias can be
 // constructed from an rvalue reference of the base Cpp type.  This means that Alias classes
@@ -188,7 +209,8 @@ void construct(value_and_holder &v_h, Cpp<Class> &&result, bool need_alias) {
     if (Class::has_alias && need_alias) {
         construct_alias_from_cpp<Class>(is_alias_constructible<Class>{}, v_h, std::move(result));
     } else {
-        v_h.value_ptr() = new Cpp<Class>(std::move(result));
+        v_h.value_ptr()
+            = construct_or_initialize_at<Cpp<Class>>(inline_value_storage(v_h), std::move(result));
     }
 }
 
@@ -298,7 +320,8 @@ struct constructor {
             "__init__",
             [](value_and_holder &v_h,
                Args... args) { // NOLINT(performance-unnecessary-value-param)
-                v_h.value_ptr() = construct_or_initialize<Cpp<Class>>(std::forward<Args>(args)...);
+                v_h.value_ptr() = construct_or_initialize_at<Cpp<Class>>(
+                    inline_value_storage(v_h), std::forward<Args>(args)...);
             },
             is_new_style_constructor(),
             extra...);
@@ -18,6 +18,8 @@
 #include "struct_smart_holder.h"
 
 #include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <limits>
@@ -227,7 +229,215 @@ struct override_hash {
     }
 };
 
+inline std::uint64_t mix64(std::uint64_t z) {
+    // David Stafford's variant 13 of the MurmurHash3 finalizer popularized
+    // by the SplitMix PRNG.
+    // https://zimbry.blogspot.com/2011/09/better-bit-mixing-improving-on.html
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+#if PYBIND11_INTERNALS_VERSION >= 13
+/// Multimap from C++ object addresses to the Python instances wrapping them. Unlike
+/// `std::unordered_multimap`, all entries are stored inline in a single open-addressing table
+/// (linear probing, kept at most half full), so registering and deregistering an instance does
+/// not allocate unless the table needs to be resized. Entries with the same address are found
+/// by scanning the probe sequence up to the next empty slot.
+///
+/// Only the part of the `std::unordered_multimap` interface used by pybind11 is provided. In
+/// contrast to the standard container, `erase` invalidates all iterators.
+class flat_instance_map {
+public:
+    using value_type = std::pair<const void *, instance *>;
+
+    class iterator {
+    public:
+        value_type &operator*() const { return map->slots[index]; }
+        value_type *operator->() const { return &map->slots[index]; }
+        iterator &operator++() {
+            index = map->find_from((index + 1) & map->mask, key);
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return index == other.index; }
+        bool operator!=(const iterator &other) const { return index != other.index; }
+
+    private:
+        friend class flat_instance_map;
+        iterator(flat_instance_map *map, size_t index, const void *key)
+            : map(map), index(index), key(key) {}
+
+        flat_instance_map *map;
+        size_t index;
+        const void *key;
+    };
+
+    flat_instance_map() = default;
+    flat_instance_map(const flat_instance_map &) = delete;
+    flat_instance_map &operator=(const flat_instance_map &) = delete;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator emplace(const void *key, instance *value) {
+        assert(key != nullptr);
+        if (capacity() == 0) {
+            rehash(min_capacity);
+        } else if (2 * (count + 1) > capacity()) {
+            rehash(2 * capacity());
+        }
+        size_t i = bucket(key);
+        while (slots[i].first != nullptr) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = value_type(key, value);
+        ++count;
+        return iterator(this, i, key);
+    }
+
+    std::pair<iterator, iterator> equal_range(const void *key) {
+        iterator end(this, npos, key);
+        if (count == 0) {
+            return {end, end};
+        }
+        return {iterator(this, find_from(bucket(key), key), key), end};
+    }
+
+    void erase(iterator it) {
+        // Backward-shift deletion: move later entries of the probe sequence into the hole
+        // (unless that would place them before their home bucket), so that no tombstones are
+        // needed and lookups can still stop at the first empty slot.
+        size_t hole = it.index;
+        for (size_t i = (hole + 1) & mask; slots[i].first != nullptr; i = (i + 1) & mask) {
+            size_t home = bucket(slots[i].first);
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole] = value_type();
+        --count;
+    }
+
+private:
+    static constexpr size_t min_capacity = 16;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t capacity() const { return slots ? mask + 1 : 0; }
+
+    size_t bucket(const void *key) const {
+        return static_cast<size_t>(mix64(reinterpret_cast<std::uintptr_t>(key)) & mask);
+    }
+
+    // Returns the index of the first entry for `key` at or after `i`, or `npos`
+    size_t find_from(size_t i, const void *key) const {
+        for (; slots[i].first != nullptr; i = (i + 1) & mask) {
+            if (slots[i].first == key) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::unique_ptr<value_type[]> old_slots(new value_type[new_capacity]);
+        size_t old_capacity = capacity();
+        old_slots.swap(slots);
+        mask = new_capacity - 1;
+        for (size_t j = 0; j < old_capacity; ++j) {
+            if (old_slots[j].first != nullptr) {
+                size_t i = bucket(old_slots[j].first);
+                while (slots[i].first != nullptr) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = old_slots[j];
+            }
+        }
+    }
+
+    std::unique_ptr<value_type[]> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
+
+using instance_map = flat_instance_map;
+#else
 using instance_map = std::unordered_multimap<const void *, instance *>;
+#endif
+
+#if PYBIND11_INTERNALS_VERSION >= 13
+// Instance freelists are not used on free-threaded builds, where instances of the same type are
+// created and destroyed concurrently, nor on PyPy and GraalPy, which manage object storage
+// themselves.
+#    if !defined(Py_GIL_DISABLED) && !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+#        define PYBIND11_HAS_INSTANCE_FREELIST
+#    endif
+
+/// Storage of destroyed instances of a type bound with `py::freelist()`, kept to be reused by
+/// new instances of the same type (see make_new_instance() and pybind11_object_dealloc()). The
+/// value/holder block of a non-simple layout stays attached to the recycled object.
+struct instance_freelist {
+    std::vector<PyObject *> objects;
+    size_t max_size = 0;
+};
+
+/// Totals over the instance freelists of all types (internals::freelist_stats)
+struct instance_freelist_stats {
+    // Instances created from storage taken from a freelist
+    size_t reused = 0;
+    // Instances of freelist types allocated with tp_alloc because the freelist was empty
+    size_t allocated = 0;
+    // Destroyed instances whose storage was added to a freelist
+    size_t recycled = 0;
+    // Destroyed instances of freelist types freed with tp_free because the freelist was full
+    size_t released = 0;
+};
+
+/// Thread states that gil_scoped_acquire created for threads unknown to Python
+/// (internals::thread_states). Shared with the threads keeping their thread state alive
+/// (py::keep_thread_states()), which may exit after the internals are destroyed.
+struct thread_state_cache {
+    std::mutex mutex;
+    // Maximum number of threads keeping their thread state alive, and their current number
+    size_t max_kept = 0; // guarded by mutex
+    size_t kept = 0;     // guarded by mutex
+    // False once the internals are destroyed, after which the kept thread states are deleted by
+    // the interpreter
+    bool alive = true; // guarded by mutex
+    // Thread states created and deleted by gil_scoped_acquire
+    std::atomic<size_t> created{0};
+    std::atomic<size_t> deleted{0};
+    // Acquisitions of the GIL that used an existing thread state of the calling thread
+    std::atomic<size_t> reused{0};
+};
+
+// Override tables rely on the type version tags of CPython, which PyPy and GraalPy don't have.
+#    if !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+#        define PYBIND11_HAS_OVERRIDE_TABLES
+#    endif
+
+/// Result of looking up the attribute `name` of a Python type for PYBIND11_OVERRIDE
+struct override_table_entry {
+    const char *name;   // Compared by pointer, like the keys of inactive_override_cache
+    PyObject *name_str; // Interned version of `name` (strong reference)
+    bool overridden;    // False if the attribute is a pybind11-bound C++ function
+};
+
+/// Attributes of a Python type looked up by get_type_override(), which are valid as long as
+/// the version tag of the type doesn't change (i.e. until the type or one of its bases is
+/// modified). See internals::override_tables.
+struct override_table {
+    unsigned int version_tag = 0;
+    std::vector<override_table_entry> entries;
+
+    void clear() {
+        for (auto &entry : entries) {
+            Py_DECREF(entry.name_str);
+        }
+        entries.clear();
+    }
+};
+#endif
 
 #ifdef Py_GIL_DISABLED
 // Wrapper around PyMutex to provide BasicLockable semantics
@@ -296,6 +506,137 @@ inline uint64_t round_up_to_next_pow2(uint64_t x) {
     x++;
     return x;
 }
+
+// Lock-free front end for the `std::type_info` -> `type_info` maps. Lookups only perform atomic
+// loads, so that once a type has been looked up, converting it never contends on the internals
+// mutex. Lookup results are cached whether or not the type is registered (a `nullptr` value
+// means "not registered").
+//
+// All modifications must be done while holding the internals mutex. Keys are only ever added,
+// values are updated in place when types are registered or deregistered. When the table gets
+// too full, its contents are copied into a table twice the size. The old table is kept alive
+// (concurrent readers may still be probing it) until the owning internals are destroyed; as the
+// capacity doubles each time, this wastes at most as much memory as the current table uses.
+class type_info_lookup_table {
+    struct slot {
+        std::atomic<const std::type_info *> key{nullptr};
+        std::atomic<type_info *> value{nullptr};
+    };
+
+    struct table {
+        explicit table(size_t capacity) : mask(capacity - 1), slots(new slot[capacity]) {}
+        size_t mask;
+        size_t size = 0;
+        std::unique_ptr<slot[]> slots;
+    };
+
+    static size_t bucket(const std::type_info *key, size_t mask) {
+        return static_cast<size_t>(mix64(reinterpret_cast<std::uintptr_t>(key)) & mask);
+    }
+
+    static slot &find_slot(table &t, const std::type_info *key) {
+        for (size_t i = bucket(key, t.mask);; i = (i + 1) & t.mask) {
+            const auto *k = t.slots[i].key.load(std::memory_order_relaxed);
+            if (k == key || k == nullptr) {
+                return t.slots[i];
+            }
+        }
+    }
+
+    std::atomic<table *> current{nullptr};
+    // All tables ever allocated, the last one is `current`
+    std::vector<std::unique_ptr<table>> tables;
+
+public:
+    /// Returns `true` and sets `value` if the lookup result for `key` is cached. Does not
+    /// require the internals mutex.
+    bool find(const std::type_info *key, type_info *&value) const {
+        const table *t = current.load(std::memory_order_acquire);
+        if (t == nullptr) {
+            return false;
+        }
+        // The load factor is at most 1/2, so there always is an empty slot to stop at
+        for (size_t i = bucket(key, t->mask);; i = (i + 1) & t->mask) {
+            const auto *k = t->slots[i].key.load(std::memory_order_acquire);
+            if (k == key) {
+                value = t->slots[i].value.load(std::memory_order_acquire);
+                return true;
+            }
+            if (k == nullptr) {
+                return false;
+            }
+        }
+    }
+
+    /// Caches `value` as the lookup result for `key`. Requires the internals mutex.
+    void store(const std::type_info *key, type_info *value) {
+        table *t = current.load(std::memory_order_relaxed);
+        if (t == nullptr || 2 * (t->size + 1) > t->mask + 1) {
+            t = grow(t);
+        }
+        auto &s = find_slot(*t, key);
+        s.value.store(value, std::memory_order_release);
+        if (s.key.load(std::memory_order_relaxed) == nullptr) {
+            s.key.store(key, std::memory_order_release);
+            ++t->size;
+        }
+    }
+
+    /// Makes lookups of `cpptype` and of all types comparing equal to it (as in `type_map`)
+    /// return `tinfo`. Requires the internals mutex.
+    void register_type(const std::type_info &cpptype, type_info *tinfo) {
+        update([&](const std::type_info &key, type_info *value) {
+            return value == nullptr && same_type(key, cpptype) ? tinfo : value;
+        });
+    }
+
+    /// Makes lookups that currently return `tinfo` return `nullptr`. Requires the internals
+    /// mutex.
+    void deregister_type(const type_info *tinfo) {
+        update([&](const std::type_info &, type_info *value) {
+            return value == tinfo ? nullptr : value;
+        });
+    }
+
+private:
+    template <typename F>
+    void update(const F &f) {
+        table *t = current.load(std::memory_order_relaxed);
+        if (t == nullptr) {
+            return;
+        }
+        for (size_t i = 0; i <= t->mask; ++i) {
+            const auto *key = t->slots[i].key.load(std::memory_order_relaxed);
+            if (key != nullptr) {
+                auto *value = t->slots[i].value.load(std::memory_order_relaxed);
+                auto *new_value = f(*key, value);
+                if (new_value != value) {
+                    t->slots[i].value.store(new_value, std::memory_order_release);
+                }
+            }
+        }
+    }
+
+    table *grow(table *old) {
+        tables.emplace_back(new table(old != nullptr ? 2 * (old->mask + 1) : 64));
+        table *t = tables.back().get();
+        if (old != nullptr) {
+            for (size_t i = 0; i <= old->mask; ++i) {
+                const auto *key = old->slots[i].key.load(std::memory_order_relaxed);
+                if (key != nullptr) {
+                    auto &s = find_slot(*t, key);
+                    s.key.store(key, std::memory_order_relaxed);
+                    s.value.store(old->slots[i].value.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+                    ++t->size;
+                }
+            }
+        }
+        // Publishes the copied contents along with the table
+        current.store(t, std::memory_order_release);
+        return t;
+    }
+};
 #endif
 
 class loader_life_support;
@@ -319,16 +660,34 @@ struct internals {
 
     // std::type_index -> pybind11's type information
     type_map<type_info *> registered_types_cpp;
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+    // Lookup results for registered_types_cpp that can be read without holding `mutex`
+    type_info_lookup_table registered_types_cpp_lock_free;
+#endif
     // PyTypeObject* -> base type_info(s)
     std::unordered_map<PyTypeObject *, std::vector<type_info *>> registered_types_py;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    // Incremented whenever types are registered or deregistered, which invalidates the
+    // per-thread caches of type lookup results (see type_info_thread_cache). Starts
+    // at a time-based value so that a cache cannot mistake a new internals object allocated at
+    // the address of a destroyed one (e.g. after reinitializing the interpreter) for the old one.
+    std::atomic<std::uint64_t> type_registry_generation{static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count())};
+#endif
 #ifdef Py_GIL_DISABLED
     std::unique_ptr<instance_map_shard[]> instance_shards; // void * -> instance*
     size_t instance_shards_mask = 0;
 #else
     instance_map registered_instances; // void * -> instance*
+#endif
+#if PYBIND11_INTERNALS_VERSION >= 13
+    instance_freelist_stats freelist_stats;
 #endif
     std::unordered_set<std::pair<const PyObject *, const char *>, override_hash>
         inactive_override_cache;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    std::unordered_map<const PyObject *, override_table> override_tables;
+#endif
     type_map<std::vector<bool (*)(PyObject *, void *&)>> direct_conversions;
     std::unordered_map<const PyObject *, std::vector<PyObject *>> patients;
     std::forward_list<ExceptionTranslator> registered_exception_translators;
@@ -346,6 +705,10 @@ struct internals {
 #endif
     // Unused if PYBIND11_SIMPLE_GIL_MANAGEMENT is defined:
     PyInterpreterState *istate = nullptr;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    // Unused if PYBIND11_SIMPLE_GIL_MANAGEMENT is defined:
+    std::shared_ptr<thread_state_cache> thread_states = std::make_shared<thread_state_cache>();
+#endif
 
     type_map<PyObject *> native_enum_type_map;
 
@@ -371,7 +734,14 @@ struct internals {
     internals(internals &&other) = delete;
     internals &operator=(const internals &other) = delete;
     internals &operator=(internals &&other) = delete;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    ~internals() {
+        std::lock_guard<std::mutex> lock(thread_states->mutex);
+        thread_states->alive = false;
+    }
+#else
     ~internals() = default;
+#endif
 };
 
 // the internals struct (above) is shared between all the modules. local_internals are only
@@ -385,6 +755,10 @@ struct local_internals {
     // data structure is scoped to our single module, and thus a single
     // DSO and single instance of type_info for any particular type.
     fast_type_map<type_info *> registered_types_cpp;
+#ifdef Py_GIL_DISABLED
+    // Lookup results for registered_types_cpp that can be read without holding the mutex
+    type_info_lookup_table registered_types_cpp_lock_free;
+#endif
 
     std::forward_list<ExceptionTranslator> registered_exception_translators;
     PyTypeObject *function_record_py_type = nullptr;
@@ -433,6 +807,15 @@ struct type_info {
     // https://github.com/wjakob/nanobind/commit/b515b1f7f2f4ecc0357818e6201c94a9f4cbfdc2
     std::forward_list<const std::type_info *> alias_chain;
 #endif
+#if PYBIND11_INTERNALS_VERSION >= 13
+    // Recycled instance storage (py::freelist), nullptr if not enabled for this type
+    std::unique_ptr<instance_freelist> freelist;
+    // Offset of the value storage inside instances (py::inline_value), 0 if values are allocated
+    // separately, and the constructors used to copy or move values into it
+    size_t inline_value_offset = 0;
+    void (*inline_copy_constructor)(void *, const void *) = nullptr;
+    void (*inline_move_constructor)(void *, const void *) = nullptr;
+#endif
 
     /* A simple type never occurs as a (direct or indirect) parent
      * of a class that makes use of multiple inheritance.
@@ -443,6 +826,12 @@ struct type_info {
     bool simple_ancestors : 1;
     /* true if this is a type registered with py::module_local */
     bool module_local : 1;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    /* true if instances are not added to registered_instances (py::no_instance_tracking) */
+    bool no_instance_tracking : 1;
+    /* true if PYBIND11_OVERRIDE uses override_call_marker (py::thread_local_override_guard) */
+    bool thread_local_override_guard : 1;
+#endif
 };
 
 /// Information stored in a capsule on py::native_enum() types. Since we don't
@@ -690,10 +1079,22 @@ public:
     std::unique_ptr<InternalsType> *get_pp() {
 #ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
         if (has_seen_non_main_interpreter()) {
+            auto *tstate = get_thread_state_unchecked();
+            // Interpreter IDs are never reused while the runtime is alive, so the
+            // pointer-to-pointer of each interpreter can be cached by ID without any thread-local
+            // state. Only interpreters with large IDs fall back to the thread-local cache.
+            if (auto *slot = interpreter_slot(tstate)) {
+                auto *pp = slot->load(std::memory_order_acquire);
+                if (!pp) {
+                    gil_scoped_acquire_simple gil;
+                    pp = get_or_create_pp_in_state_dict();
+                    slot->store(pp, std::memory_order_release);
+                }
+                return pp;
+            }
             // Whenever the interpreter changes on the current thread we need to invalidate the
             // internals_pp so that it can be pulled from the interpreter's state dict.  That is
             // slow, so we use the current PyThreadState to check if it is necessary.
-            auto *tstate = get_thread_state_unchecked();
             if (!tstate || tstate->interp != last_istate_tls()) {
                 gil_scoped_acquire_simple gil;
                 if (!tstate) {
@@ -716,6 +1117,9 @@ public:
     void unref() {
 #ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
         if (has_seen_non_main_interpreter()) {
+            if (auto *slot = interpreter_slot(get_thread_state_unchecked())) {
+                slot->store(nullptr, std::memory_order_release);
+            }
             last_istate_tls() = nullptr;
             internals_p_tls() = nullptr;
             return;
@@ -724,29 +1128,40 @@ public:
         internals_singleton_pp_ = nullptr;
     }
 
-    void destroy() {
+    /// Drop the references held for all interpreters. Only safe while no interpreter is running
+    /// pybind11 code on other threads.
+    void unref_all() {
 #ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
-        if (has_seen_non_main_interpreter()) {
-            auto *tstate = get_thread_state_unchecked();
-            // this could be called without an active interpreter, just use what was cached
-            if (!tstate || tstate->interp == last_istate_tls()) {
-                auto tpp = internals_p_tls();
-                {
-                    std::lock_guard<std::mutex> lock(pp_set_mutex_);
-                    pps_have_created_content_.erase(tpp); // untrack deleted pp
-                }
-                delete tpp; // may call back into Python
-            }
-            unref();
-            return;
+        for (auto &slot : pp_by_interpreter_id_) {
+            slot.store(nullptr, std::memory_order_relaxed);
         }
+        last_istate_tls() = nullptr;
+        internals_p_tls() = nullptr;
 #endif
+        internals_singleton_pp_ = nullptr;
+    }
+
+    /// Destroy the content of `pp` (as returned by `get_pp()`), whose interpreter may already have
+    /// been finalized.
+    void destroy(std::unique_ptr<InternalsType> *pp) {
         {
             std::lock_guard<std::mutex> lock(pp_set_mutex_);
-            pps_have_created_content_.erase(internals_singleton_pp_); // untrack deleted pp
+            pps_have_created_content_.erase(pp); // untrack deleted pp
+        }
+#ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
+        for (auto &slot : pp_by_interpreter_id_) {
+            auto *expected = pp;
+            slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        }
+        if (internals_p_tls() == pp) {
+            last_istate_tls() = nullptr;
+            internals_p_tls() = nullptr;
         }
-        delete internals_singleton_pp_; // may call back into Python
-        unref();
+#endif
+        if (internals_singleton_pp_ == pp) {
+            internals_singleton_pp_ = nullptr;
+        }
+        delete pp; // may call back into Python
     }
 
     void create_pp_content_once(std::unique_ptr<InternalsType> *const pp) {
@@ -810,6 +1225,19 @@ private:
     }
 
 #ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
+    static constexpr Py_ssize_t num_interpreter_slots = 64;
+
+    std::atomic<std::unique_ptr<InternalsType> *> *interpreter_slot(PyThreadState *tstate) {
+        if (!tstate) {
+            return nullptr;
+        }
+        auto id = PyInterpreterState_GetID(tstate->interp);
+        if (id < 0 || id >= num_interpreter_slots) {
+            return nullptr;
+        }
+        return &pp_by_interpreter_id_[id];
+    }
+
     static PyInterpreterState *&last_istate_tls() {
         static thread_local PyInterpreterState *last_istate = nullptr;
         return last_istate;
@@ -826,6 +1254,12 @@ private:
     // Pointer-to-pointer to the singleton internals for the first seen interpreter (may not be the
     // main interpreter)
     std::unique_ptr<InternalsType> *internals_singleton_pp_ = nullptr;
+#ifdef PYBIND11_HAS_SUBINTERPRETER_SUPPORT
+    // Pointer-to-pointers of the interpreters with the smallest IDs, once multiple interpreters
+    // have been seen
+    std::atomic<std::unique_ptr<InternalsType> *> pp_by_interpreter_id_[num_interpreter_slots]
+        = {};
+#endif
 
     // Track pointer-to-pointers whose internals have been created, to detect re-entrancy.
     // Use instance member over static due to singleton pattern of this class.
@@ -982,15 +1416,6 @@ inline auto with_exception_translators(const F &cb)
               local_internals.registered_exception_translators);
 }
 
-inline std::uint64_t mix64(std::uint64_t z) {
-    // David Stafford's variant 13 of the MurmurHash3 finalizer popularized
-    // by the SplitMix PRNG.
-    // https://zimbry.blogspot.com/2011/09/better-bit-mixing-improving-on.html
-    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
-    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
-    return z ^ (z >> 31);
-}
-
 template <typename F>
 inline auto with_instance_map(const void *ptr, const F &cb)
     -> decltype(cb(std::declval<instance_map &>())) {
@@ -118,6 +118,73 @@ public:
 inline std::pair<decltype(internals::registered_types_py)::iterator, bool>
 all_type_info_get_cache(PyTypeObject *type);
 
+#if PYBIND11_INTERNALS_VERSION >= 13
+/// Small, direct-mapped, per-thread cache of the results of `get_type_info(const std::type_info
+/// &)`, so that repeated conversions of the same types skip the hash map lookups (and on
+/// free-threaded builds, the internals mutex). All entries are dropped when
+/// `internals::type_registry_generation` changes or when the thread moves to another interpreter.
+/// As the cache lives in a function-local `thread_local`, every module has its own, which is
+/// required because the results of `get_type_info` depend on the module-local types.
+class type_info_thread_cache {
+    static constexpr size_t num_entries = 16;
+
+    struct entry {
+        const std::type_info *key;
+        type_info *value;
+    };
+
+    const internals *owner = nullptr;
+    std::uint64_t generation_ = 0;
+    entry entries[num_entries] = {};
+
+    entry &slot(const std::type_info *key) {
+        return entries[mix64(reinterpret_cast<std::uintptr_t>(key)) & (num_entries - 1)];
+    }
+
+    PYBIND11_NOINLINE void reset(const internals &internals, std::uint64_t generation) {
+        *this = type_info_thread_cache();
+        owner = &internals;
+        generation_ = generation;
+    }
+
+    // Computing the address of a thread_local in a shared library involves a call into the
+    // dynamic linker, which compilers tend to repeat for every access when this is inlined.
+    PYBIND11_NOINLINE static type_info_thread_cache *thread_instance() {
+        static thread_local type_info_thread_cache cache;
+        return &cache;
+    }
+
+public:
+    /// Returns the cache of the calling thread, after dropping any stale entries.
+    static type_info_thread_cache &get() {
+        const auto &internals = get_internals();
+        auto generation = internals.type_registry_generation.load(std::memory_order_acquire);
+        auto *cache = thread_instance();
+        if (cache->owner != &internals || cache->generation_ != generation) {
+            cache->reset(internals, generation);
+        }
+        return *cache;
+    }
+
+    /// The generation to pass to `store()` for results looked up after calling `get()`. If the
+    /// generation changed in between (e.g. because the lookup deallocated a type), the result is
+    /// not stored.
+    std::uint64_t generation() const { return generation_; }
+
+    bool find(const std::type_info *key, type_info *&value) {
+        const auto &e = slot(key);
+        value = e.value;
+        return e.key == key;
+    }
+
+    void store(const std::type_info *key, type_info *value, std::uint64_t generation) {
+        if (generation == generation_) {
+            slot(key) = {key, value};
+        }
+    }
+};
+#endif
+
 // Band-aid workaround to fix a subtle but serious bug in a minimalistic fashion. See PR #4762.
 inline void all_type_info_add_base_most_derived_first(std::vector<type_info *> &bases,
                                                       type_info *addl_base) {
@@ -217,15 +284,23 @@ PYBIND11_NOINLINE detail::type_info *get_type_info(PyTypeObject *type) {
 }
 
 inline detail::type_info *get_local_type_info_lock_held(const std::type_info &tp) {
-    const auto &locals = get_local_internals().registered_types_cpp;
+    auto &local_internals = get_local_internals();
+    const auto &locals = local_internals.registered_types_cpp;
     auto it = locals.find(&tp);
-    if (it != locals.end()) {
-        return it->second;
-    }
-    return nullptr;
+    detail::type_info *type_info = it != locals.end() ? it->second : nullptr;
+#ifdef Py_GIL_DISABLED
+    local_internals.registered_types_cpp_lock_free.store(&tp, type_info);
+#endif
+    return type_info;
 }
 
 inline detail::type_info *get_local_type_info(const std::type_info &tp) {
+#ifdef Py_GIL_DISABLED
+    detail::type_info *type_info = nullptr;
+    if (get_local_internals().registered_types_cpp_lock_free.find(&tp, type_info)) {
+        return type_info;
+    }
+#endif
     // NB: internals and local_internals share a single mutex
     PYBIND11_LOCK_INTERNALS(get_internals());
     return get_local_type_info_lock_held(tp);
@@ -266,24 +341,60 @@ inline detail::type_info *get_global_type_info_lock_held(const std::type_info &t
 #endif
         type_info = it->second;
     }
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+    internals.registered_types_cpp_lock_free.store(&tp, type_info);
+#endif
     return type_info;
 }
 
 inline detail::type_info *get_global_type_info(const std::type_info &tp) {
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+    detail::type_info *type_info = nullptr;
+    if (get_internals().registered_types_cpp_lock_free.find(&tp, type_info)) {
+        return type_info;
+    }
+#endif
     PYBIND11_LOCK_INTERNALS(get_internals());
     return get_global_type_info_lock_held(tp);
 }
 
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+/// Looks up the type info for a given C++ type without taking the internals mutex. Returns false
+/// if the result of the lookup has not been cached yet.
+inline bool get_type_info_lock_free(const std::type_info &tp, detail::type_info *&type_info) {
+    return get_local_internals().registered_types_cpp_lock_free.find(&tp, type_info)
+           && (type_info != nullptr
+               || get_internals().registered_types_cpp_lock_free.find(&tp, type_info));
+}
+#endif
+
 /// Return the type info for a given C++ type; on lookup failure can either throw or return
 /// nullptr.
 PYBIND11_NOINLINE detail::type_info *get_type_info(const std::type_info &tp,
                                                    bool throw_if_missing = false) {
-    PYBIND11_LOCK_INTERNALS(get_internals());
-    if (auto *ltype = get_local_type_info_lock_held(tp)) {
-        return ltype;
+    detail::type_info *type_info = nullptr;
+#if PYBIND11_INTERNALS_VERSION >= 13
+    auto &cache = type_info_thread_cache::get();
+    const auto generation = cache.generation();
+    if (cache.find(&tp, type_info) && (type_info != nullptr || !throw_if_missing)) {
+        return type_info;
     }
-    if (auto *gtype = get_global_type_info_lock_held(tp)) {
-        return gtype;
+#endif
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+    if (!get_type_info_lock_free(tp, type_info))
+#endif
+    {
+        PYBIND11_LOCK_INTERNALS(get_internals());
+        type_info = get_local_type_info_lock_held(tp);
+        if (type_info == nullptr) {
+            type_info = get_global_type_info_lock_held(tp);
+        }
+    }
+#if PYBIND11_INTERNALS_VERSION >= 13
+    cache.store(&tp, type_info, generation);
+#endif
+    if (type_info != nullptr) {
+        return type_info;
     }
 
     if (throw_if_missing) {
@@ -346,6 +457,11 @@ inline bool try_incref(PyObject *obj) {
 // Searches the inheritance graph for a registered Python instance, using all_type_info().
 PYBIND11_NOINLINE handle find_registered_python_instance(void *src,
                                                          const detail::type_info *tinfo) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (tinfo->no_instance_tracking) {
+        return handle();
+    }
+#endif
     return with_instance_map(src, [&](instance_map &instances) {
         auto it_instances = instances.equal_range(src);
         for (auto it_i = it_instances.first; it_i != it_instances.second; ++it_i) {
@@ -373,6 +489,8 @@ public:
     explicit values_and_holders(instance *inst)
         : inst{inst}, tinfo(all_type_info(Py_TYPE(inst))) {}
 
+    values_and_holders(instance *inst, const type_vec &tinfo) : inst{inst}, tinfo(tinfo) {}
+
     explicit values_and_holders(PyObject *obj)
         : inst{nullptr}, tinfo(all_type_info(Py_TYPE(obj))) {
         if (!tinfo.empty()) {
@@ -480,8 +598,10 @@ instance::get_value_and_holder(const type_info *find_type /*= nullptr default in
 }
 
 PYBIND11_NOINLINE void instance::allocate_layout() {
-    const auto &tinfo = all_type_info(Py_TYPE(this));
+    allocate_layout(all_type_info(Py_TYPE(this)));
+}
 
+PYBIND11_NOINLINE void instance::allocate_layout(const std::vector<type_info *> &tinfo) {
     const size_t n_types = tinfo.size();
 
     if (n_types == 0) {
@@ -517,9 +637,15 @@ PYBIND11_NOINLINE void instance::allocate_layout() {
         // efficient for small allocations like the one we're doing here;
         // for larger allocations they are just wrappers around malloc.
         // TODO: is this still true for pure Python 3.6?
-        nonsimple.values_and_holders = static_cast<void **>(PyMem_Calloc(space, sizeof(void *)));
-        if (!nonsimple.values_and_holders) {
-            throw std::bad_alloc();
+        if (nonsimple.values_and_holders != nullptr) {
+            // Storage taken from an instance freelist, see make_new_instance()
+            std::memset(nonsimple.values_and_holders, 0, space * sizeof(void *));
+        } else {
+            nonsimple.values_and_holders
+                = static_cast<void **>(PyMem_Calloc(space, sizeof(void *)));
+            if (!nonsimple.values_and_holders) {
+                throw std::bad_alloc();
+            }
         }
         nonsimple.status
             = reinterpret_cast<std::uint8_t *>(&nonsimple.values_and_holders[flags_at]);
@@ -534,6 +660,56 @@ PYBIND11_NOINLINE void instance::deallocate_layout() {
     }
 }
 
+/// Returns the storage for a value of type `tinfo` inside the Python object `inst`
+/// (py::inline_value), or nullptr if values of the type are allocated separately.
+inline void *inline_value_storage(instance *inst, const type_info *tinfo) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (tinfo->inline_value_offset != 0) {
+        return reinterpret_cast<char *>(inst) + tinfo->inline_value_offset;
+    }
+#else
+    (void) inst;
+    (void) tinfo;
+#endif
+    return nullptr;
+}
+
+inline void *inline_value_storage(const value_and_holder &v_h) {
+    return inline_value_storage(v_h.inst, v_h.type);
+}
+
+/// True if the value of `v_h` is stored inside its Python object. Such values are owned by the
+/// Python object itself: their holder is flagged as constructed, but never actually is.
+inline bool value_is_inline(const value_and_holder &v_h) {
+    void *storage = inline_value_storage(v_h);
+    return storage != nullptr && v_h.value_ptr() == storage;
+}
+
+/// Copy- or move-constructs `src` into the inline value storage of `inst`, returning nullptr if
+/// values of type `tinfo` are not stored inline or cannot be copied/moved.
+inline void *
+construct_inline_value(instance *inst, const type_info *tinfo, const void *src, bool move) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    void *storage = inline_value_storage(inst, tinfo);
+    if (storage != nullptr) {
+        if (move && tinfo->inline_move_constructor) {
+            tinfo->inline_move_constructor(storage, src);
+            return storage;
+        }
+        if (tinfo->inline_copy_constructor) {
+            tinfo->inline_copy_constructor(storage, src);
+            return storage;
+        }
+    }
+#else
+    (void) inst;
+    (void) tinfo;
+    (void) src;
+    (void) move;
+#endif
+    return nullptr;
+}
+
 PYBIND11_NOINLINE bool isinstance_generic(handle obj, const std::type_info &tp) {
     handle type = detail::get_type_handle(tp, false);
     if (!type) {
@@ -761,6 +937,7 @@ handle smart_holder_from_shared_ptr(const std::shared_ptr<T> &src,
     switch (policy) {
         case return_value_policy::automatic:
         case return_value_policy::automatic_reference:
+        case return_value_policy::lazy_sequence:
             break;
         case return_value_policy::take_ownership:
             throw cast_error("Invalid return_value_policy for shared_ptr (take_ownership).");
@@ -1053,6 +1230,19 @@ public:
         if (handle registered_inst = find_registered_python_instance(src, tinfo)) {
             return registered_inst;
         }
+#if PYBIND11_INTERNALS_VERSION >= 13
+        // Without the registry, a raw pointer already owned by another instance can't be
+        // detected, and taking ownership of it again would delete the object twice.
+        if (tinfo->no_instance_tracking && existing_holder == nullptr
+            && (policy == return_value_policy::automatic
+                || policy == return_value_policy::take_ownership)) {
+            throw cast_error("return_value_policy::take_ownership (the automatic policy for "
+                             "pointers) is not supported for types with "
+                             "py::no_instance_tracking(): use return_value_policy::copy or "
+                             "return_value_policy::reference, or return a holder such as "
+                             "std::unique_ptr");
+        }
+#endif
 
         auto inst = reinterpret_steal<object>(make_new_instance(tinfo->type));
         auto *wrapper = reinterpret_cast<instance *>(inst.ptr());
@@ -1073,7 +1263,10 @@ public:
                 break;
 
             case return_value_policy::copy:
-                if (copy_constructor) {
+                if (void *inline_ptr
+                    = construct_inline_value(wrapper, tinfo, src, /*move=*/false)) {
+                    valueptr = inline_ptr;
+                } else if (copy_constructor) {
                     valueptr = copy_constructor(src);
                 } else {
 #if defined(PYBIND11_DETAILED_ERROR_MESSAGES)
@@ -1091,7 +1284,10 @@ public:
                 break;
 
             case return_value_policy::move:
-                if (move_constructor) {
+                if (void *inline_ptr
+                    = construct_inline_value(wrapper, tinfo, src, /*move=*/true)) {
+                    valueptr = inline_ptr;
+                } else if (move_constructor) {
                     valueptr = move_constructor(src);
                 } else if (copy_constructor) {
                     valueptr = copy_constructor(src);
@@ -183,10 +183,10 @@ inline void initialize_interpreter(bool init_signal_handlers = true,
 
  \endrst */
 inline void finalize_interpreter() {
-    // get rid of any thread-local interpreter cache that currently exists
+    // get rid of any interpreter cache that currently exists
     if (detail::has_seen_non_main_interpreter()) {
-        detail::get_internals_pp_manager().unref();
-        detail::get_local_internals_pp_manager().unref();
+        detail::get_internals_pp_manager().unref_all();
+        detail::get_local_internals_pp_manager().unref_all();
 
         // We know there can be no other interpreter alive now
         detail::has_seen_non_main_interpreter() = false;
@@ -196,16 +196,16 @@ inline void finalize_interpreter() {
     // exist). It's possible for the  internals to be created during Py_Finalize() (e.g. if a
     // py::capsule calls `get_internals()` during destruction), so we get the pointer-pointer here
     // and check it after Py_Finalize().
-    detail::get_internals_pp_manager().get_pp();
-    detail::get_local_internals_pp_manager().get_pp();
+    auto *internals_pp = detail::get_internals_pp_manager().get_pp();
+    auto *local_internals_pp = detail::get_local_internals_pp_manager().get_pp();
 
     Py_Finalize();
 
-    detail::get_internals_pp_manager().destroy();
+    detail::get_internals_pp_manager().destroy(internals_pp);
 
     // Local internals contains data managed by the current interpreter, so we must clear them to
     // avoid undefined behaviors when initializing another interpreter
-    detail::get_local_internals_pp_manager().destroy();
+    detail::get_local_internals_pp_manager().destroy(local_internals_pp);
 
     // We know there is no interpreter alive now, so we can reset the multi-flag
     detail::has_seen_non_main_interpreter() = false;
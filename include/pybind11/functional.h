@@ -11,7 +11,14 @@
 
 #include "pybind11.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
 PYBIND11_NAMESPACE_BEGIN(detail)
@@ -49,6 +56,23 @@ struct func_wrapper : func_wrapper_base {
     }
 };
 
+// calls a pybind11-bound C++ function directly (see function_record::direct_call), keeping the
+// Python function object that owns its function record alive
+template <typename Return, typename... Args>
+struct direct_func_wrapper : func_wrapper_base {
+    using direct_call_t = Return (*)(const function_record &, Args...);
+
+    direct_func_wrapper(func_handle &&hf, const function_record *rec) noexcept
+        : func_wrapper_base(std::move(hf)), rec(rec),
+          call(reinterpret_cast<direct_call_t>(rec->direct_call)) {}
+    Return operator()(Args... args) const { // NOLINT(performance-unnecessary-value-param)
+        return call(*rec, std::forward<Args>(args)...);
+    }
+
+    const function_record *rec;
+    direct_call_t call;
+};
+
 PYBIND11_NAMESPACE_END(type_caster_std_function_specializations)
 
 template <typename Return, typename... Args>
@@ -77,9 +101,10 @@ public:
            When passing a C++ function as an argument to another C++
            function via Python, every function call would normally involve
            a full C++ -> Python -> C++ roundtrip, which can be prohibitive.
-           Here, we try to at least detect the case where the function is
-           stateless (i.e. function pointer or lambda function without
-           captured variables), in which case the roundtrip can be avoided.
+           Here, we try to detect the case where the function is stateless
+           (i.e. function pointer or lambda function without captured
+           variables), or otherwise has exactly the same signature, in
+           which case the roundtrip can be avoided.
          */
         if (auto cfunc = func.cpp_function()) {
             auto *cfunc_self = PyCFunction_GET_SELF(cfunc.ptr());
@@ -87,6 +112,7 @@ public:
                 PyErr_Clear();
             } else {
                 function_record *rec = function_record_ptr_from_PyObject(cfunc_self);
+                function_record *direct = nullptr;
                 while (rec != nullptr) {
                     if (rec->is_stateless
                         && same_type(typeid(function_type),
@@ -103,8 +129,18 @@ public:
                         value = capture::from_data(rec->data)->f;
                         return true;
                     }
+                    if (direct == nullptr && rec->direct_call != nullptr
+                        && same_type(typeid(function_type), *rec->direct_call_type)) {
+                        direct = rec;
+                    }
                     rec = rec->next;
                 }
+                if (direct != nullptr) {
+                    using namespace type_caster_std_function_specializations;
+                    value = direct_func_wrapper<Return, Args...>(func_handle(std::move(func)),
+                                                                 direct);
+                    return true;
+                }
             }
             // PYPY segfaults here when passing builtin function like sum.
             // Raising an fail exception here works to prevent the segfault, but only on gcc.
@@ -126,6 +162,12 @@ public:
         if (result) {
             return cpp_function(*result, policy).release();
         }
+        // Return the original bound function instead of wrapping it once more
+        using direct_wrapper
+            = type_caster_std_function_specializations::direct_func_wrapper<Return, Args...>;
+        if (const auto *direct = f_.template target<direct_wrapper>()) {
+            return direct->hfunc.f.inc_ref();
+        }
         return cpp_function(std::forward<Func>(f_), policy).release();
     }
 
@@ -137,4 +179,158 @@ public:
 };
 
 PYBIND11_NAMESPACE_END(detail)
+
+/// Queues calls of a Python callable made from C++ worker threads and runs them in batches, so
+/// that the GIL is acquired once per batch instead of once per call. Return values are discarded.
+/// The arguments are stored by value and destroyed without holding the GIL, so they should not
+/// be Python objects.
+template <typename Signature>
+class callback_queue;
+
+template <typename... Args>
+class callback_queue<void(Args...)> {
+    using clock = std::chrono::steady_clock;
+
+public:
+    struct statistics {
+        size_t enqueued = 0;       // calls accepted by push() and try_push()
+        size_t rejected = 0;       // try_push() calls that found the queue full
+        size_t executed = 0;       // calls run by drain()
+        size_t batches = 0;        // drain() calls that ran at least one call
+        size_t max_batch_size = 0; // largest number of calls run under one GIL acquisition
+        // Time from enqueueing a call until it is started, summed up and maximum
+        std::chrono::nanoseconds total_latency{0};
+        std::chrono::nanoseconds max_latency{0};
+    };
+
+    /// Creates a queue holding at most `capacity` pending calls of `func`
+    explicit callback_queue(function func, size_t capacity = 1024)
+        : hfunc(std::move(func)), capacity(capacity == 0 ? 1 : capacity) {}
+
+    callback_queue(const callback_queue &) = delete;
+    callback_queue &operator=(const callback_queue &) = delete;
+
+    /// Enqueues a call, waiting while the queue is full. The GIL is released while waiting, so
+    /// that another thread can drain the queue.
+    void push(Args... args) { // NOLINT(performance-unnecessary-value-param)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending.size() < capacity) {
+                enqueue(std::forward<Args>(args)...);
+                return;
+            }
+        }
+        std::unique_ptr<gil_scoped_release> release;
+        if (PyGILState_Check() != 0) {
+            release.reset(new gil_scoped_release());
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return pending.size() < capacity; });
+        enqueue(std::forward<Args>(args)...);
+    }
+
+    /// Enqueues a call unless the queue is full. Returns whether the call was enqueued.
+    bool try_push(Args... args) { // NOLINT(performance-unnecessary-value-param)
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.size() >= capacity) {
+            ++stats_.rejected;
+            return false;
+        }
+        enqueue(std::forward<Args>(args)...);
+        return true;
+    }
+
+    /// Runs up to `max_calls` pending calls in order under a single GIL acquisition and returns
+    /// how many were run. If a call throws, the calls after it stay queued and the exception is
+    /// propagated.
+    size_t drain(size_t max_calls = static_cast<size_t>(-1)) {
+        std::vector<entry> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t n = (std::min)(max_calls, pending.size());
+            batch.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                batch.push_back(std::move(pending.front()));
+                pending.pop_front();
+            }
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+        not_full.notify_all();
+
+        std::chrono::nanoseconds total_latency{0}, max_latency{0};
+        size_t done = 0;
+        try {
+            gil_scoped_acquire acq;
+            for (; done < batch.size(); ++done) {
+                auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    clock::now() - batch[done].enqueued);
+                total_latency += latency;
+                max_latency = (std::max)(max_latency, latency);
+                invoke(batch[done].args, detail::make_index_sequence<sizeof...(Args)>());
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            // The failed call counts as executed; the ones after it go back to the front
+            record_batch(done + 1, total_latency, max_latency);
+            for (size_t i = batch.size(); i > done + 1; --i) {
+                pending.push_front(std::move(batch[i - 1]));
+            }
+            throw;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        record_batch(done, total_latency, max_latency);
+        return done;
+    }
+
+    /// Number of pending calls
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending.size();
+    }
+
+    statistics stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats_;
+    }
+
+private:
+    using args_tuple = std::tuple<typename std::decay<Args>::type...>;
+
+    struct entry {
+        args_tuple args;
+        clock::time_point enqueued;
+    };
+
+    // Requires `mutex` to be held
+    template <typename... Ts>
+    void enqueue(Ts &&...args) {
+        pending.push_back(entry{args_tuple(std::forward<Ts>(args)...), clock::now()});
+        ++stats_.enqueued;
+    }
+
+    template <typename Tuple, size_t... Is>
+    void invoke(Tuple &args, detail::index_sequence<Is...>) {
+        hfunc.f(std::move(std::get<Is>(args))...);
+    }
+
+    void record_batch(size_t n,
+                      std::chrono::nanoseconds total_latency,
+                      std::chrono::nanoseconds max_latency) {
+        stats_.executed += n;
+        ++stats_.batches;
+        stats_.max_batch_size = (std::max)(stats_.max_batch_size, n);
+        stats_.total_latency += total_latency;
+        stats_.max_latency = (std::max)(stats_.max_latency, max_latency);
+    }
+
+    detail::type_caster_std_function_specializations::func_handle hfunc;
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::condition_variable not_full;
+    std::deque<entry> pending;
+    statistics stats_;
+};
+
 PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
@@ -27,6 +27,9 @@ PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
 #    include "detail/internals.h"
 
 #    include <cassert>
+#    include <memory>
+#    include <mutex>
+#    include <vector>
 
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
 
@@ -40,6 +43,82 @@ PyThreadState *get_thread_state_unchecked();
 
 PYBIND11_WARNING_POP
 
+#    if PYBIND11_INTERNALS_VERSION >= 13
+/// Holds a reference to the thread states that gil_scoped_acquire created for the current thread
+/// and kept alive (see py::keep_thread_states()), and deletes them when the thread exits.
+class thread_state_keeper {
+public:
+    thread_state_keeper() = default;
+    thread_state_keeper(const thread_state_keeper &) = delete;
+    thread_state_keeper &operator=(const thread_state_keeper &) = delete;
+
+    ~thread_state_keeper() {
+        for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+            release(*it);
+        }
+    }
+
+    void add(internals &internals, PyThreadState *tstate) {
+        kept.push_back(entry{tstate, &internals, internals.thread_states});
+    }
+
+private:
+    struct entry {
+        PyThreadState *tstate;
+        internals *owner;
+        std::shared_ptr<thread_state_cache> cache;
+    };
+
+    static void release(const entry &e) {
+        {
+            std::lock_guard<std::mutex> lock(e.cache->mutex);
+            if (!e.cache->alive) {
+                return; // Already deleted along with the interpreter
+            }
+            --e.cache->kept;
+        }
+#        if PY_VERSION_HEX >= 0x030D0000
+        if (Py_IsInitialized() == 0 || Py_IsFinalizing() != 0) {
+#        else
+        if (Py_IsInitialized() == 0 || _Py_IsFinalizing() != 0) {
+#        endif
+            return;
+        }
+        PyEval_AcquireThread(e.tstate);
+        if (--e.tstate->gilstate_counter != 0) {
+            // Still used by a gil_scoped_acquire that was never destroyed
+            PyEval_SaveThread();
+            return;
+        }
+        // See gil_scoped_acquire::dec_ref()
+        ++e.tstate->gilstate_counter;
+        PyThreadState_Clear(e.tstate);
+        --e.tstate->gilstate_counter;
+        PyThreadState_DeleteCurrent();
+        e.owner->tstate.reset();
+        ++e.cache->deleted;
+    }
+
+    std::vector<entry> kept;
+};
+
+/// Registers a thread state that was just created for the current thread to be kept alive until
+/// the thread exits, unless the limit set with py::keep_thread_states() is reached
+inline bool keep_thread_state(internals &internals, PyThreadState *tstate) {
+    auto &cache = *internals.thread_states;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.kept >= cache.max_kept) {
+            return false;
+        }
+        ++cache.kept;
+    }
+    static thread_local thread_state_keeper keeper;
+    keeper.add(internals, tstate);
+    return true;
+}
+#    endif
+
 PYBIND11_NAMESPACE_END(detail)
 
 /* The functions below essentially reproduce the PyGILState_* API using a RAII
@@ -88,8 +167,20 @@ public:
 #    endif
             tstate->gilstate_counter = 0;
             internals.tstate = tstate;
+#    if PYBIND11_INTERNALS_VERSION >= 13
+            ++internals.thread_states->created;
+            if (detail::keep_thread_state(internals, tstate)) {
+                // This reference is owned by the thread_state_keeper of this thread
+                inc_ref();
+            }
+#    endif
         } else {
             release = detail::get_thread_state_unchecked() != tstate;
+#    if PYBIND11_INTERNALS_VERSION >= 13
+            if (release) {
+                ++internals.thread_states->reused;
+            }
+#    endif
         }
 
         if (release) {
@@ -128,7 +219,13 @@ public:
             if (active) {
                 PyThreadState_DeleteCurrent();
             }
-            detail::get_internals().tstate.reset();
+            auto &internals = detail::get_internals();
+            internals.tstate.reset();
+#    if PYBIND11_INTERNALS_VERSION >= 13
+            if (active) {
+                ++internals.thread_states->deleted;
+            }
+#    endif
             release = false;
         }
     }
@@ -153,6 +250,19 @@ private:
     bool active = true;
 };
 
+#    if PYBIND11_INTERNALS_VERSION >= 13
+/// Makes gil_scoped_acquire keep the thread states it creates for threads unknown to Python
+/// alive until these threads exit, for up to `max_threads` threads of the current interpreter.
+/// Threads that acquire the GIL repeatedly then create their thread state only once. The
+/// default of 0 deletes a thread state whenever the outermost gil_scoped_acquire is destroyed.
+/// Must be called with the GIL held.
+inline void keep_thread_states(size_t max_threads) {
+    auto &cache = *detail::get_internals().thread_states;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.max_kept = max_threads;
+}
+#    endif
+
 class gil_scoped_release {
 public:
     // PRECONDITION: The GIL must be held when this constructor is called.
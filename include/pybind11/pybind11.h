@@ -24,7 +24,10 @@
 #include "trampoline_self_life_support.h"
 #include "typing.h"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -108,6 +111,84 @@ inline std::string replace_newlines_and_squash(const char *text) {
     return result.substr(str_begin, str_range);
 }
 
+/// True while the durations of calls are recorded (py::enable_call_profiling()). Each extension
+/// module has its own flag.
+inline std::atomic<bool> &call_profiling_enabled() {
+    static std::atomic<bool> enabled{false};
+    return enabled;
+}
+
+/// Call guard of functions annotated with py::release_gil_if_args_loaded
+class gil_release_if_args_loaded_guard {
+public:
+    explicit gil_release_if_args_loaded_guard(const function_record &rec) {
+        if (rec.release_gil) {
+            tstate = PyEval_SaveThread();
+        }
+    }
+
+    gil_release_if_args_loaded_guard(const gil_release_if_args_loaded_guard &) = delete;
+    gil_release_if_args_loaded_guard &operator=(const gil_release_if_args_loaded_guard &)
+        = delete;
+
+    ~gil_release_if_args_loaded_guard() {
+        if (tstate != nullptr) {
+            PyEval_RestoreThread(tstate);
+        }
+    }
+
+private:
+    PyThreadState *tstate = nullptr;
+};
+
+/// True if `T` is a Python object or a type (e.g. a container) with Python objects inside
+template <typename T>
+struct holds_python_objects
+    : bool_constant<is_pyobject<T>::value || std::is_same<T, PyObject>::value> {};
+
+template <template <typename...> class Tmpl, typename... Ts>
+struct holds_python_objects<Tmpl<Ts...>>
+    : bool_constant<is_pyobject<Tmpl<Ts...>>::value
+                    || any_of<holds_python_objects<intrinsic_t<Ts>>...>::value> {};
+
+template <typename T, size_t N>
+struct holds_python_objects<std::array<T, N>> : holds_python_objects<intrinsic_t<T>> {};
+
+/// Records the duration of a call of `rec` (see py::enable_call_profiling())
+inline void record_call_duration(const function_record &rec, std::uint64_t ns) {
+    auto &slot = const_cast<function_record &>(rec).call_durations;
+    auto *histogram = slot.load(std::memory_order_acquire);
+    if (histogram == nullptr) {
+        auto *created = new call_duration_histogram();
+        if (slot.compare_exchange_strong(histogram, created, std::memory_order_acq_rel)) {
+            histogram = created;
+        } else {
+            delete created; // Another thread was first, `histogram` is now its histogram
+        }
+    }
+    histogram->record(ns);
+}
+
+/// Calls the implementation of an overload. While call profiling is enabled, also records the
+/// duration of the successful calls of functions which could release the GIL (including the
+/// conversion of the arguments and of the result).
+inline handle call_overload_impl(function_call &call) {
+    const function_record &rec = call.func;
+    if (!rec.can_release_gil || !call_profiling_enabled().load(std::memory_order_relaxed)) {
+        return rec.impl(call);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    handle result = rec.impl(call);
+    if (result.ptr() != PYBIND11_TRY_NEXT_OVERLOAD) {
+        record_call_duration(rec,
+                             static_cast<std::uint64_t>(
+                                 std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count()));
+    }
+    return result;
+}
+
 /* Generate a proper function signature */
 inline std::string generate_function_signature(const char *type_caster_name_field,
                                                detail::function_record *func_rec,
@@ -511,17 +592,44 @@ private:
 
         /* Perform the function call */
         handle result;
+        using guard_takes_record
+            = std::is_same<Guard, detail::gil_release_if_args_loaded_guard>;
         if (call.func.is_setter) {
-            (void) std::move(args_converter).template call<Return, Guard>(f);
+            (void) call_guarded<Return, Guard>(
+                std::move(args_converter), f, call.func, guard_takes_record());
             result = none().release();
         } else {
-            result = cast_out::cast(
-                std::move(args_converter).template call<Return, Guard>(f), policy, call.parent);
+            result = cast_out::cast(call_guarded<Return, Guard>(std::move(args_converter),
+                                                                f,
+                                                                call.func,
+                                                                guard_takes_record()),
+                                    policy,
+                                    call.parent);
         }
 
         return result;
     }
 
+    // Calls the function within the scope of the call guard, which is constructed from the
+    // function record if it needs it
+    template <typename Return, typename Guard, typename ArgsConverter, typename Func>
+    static auto call_guarded(ArgsConverter &&args_converter,
+                             Func f,
+                             const detail::function_record &,
+                             std::false_type /* guard_takes_record */)
+        -> decltype(std::move(args_converter).template call<Return, Guard>(f)) {
+        return std::move(args_converter).template call<Return, Guard>(f);
+    }
+
+    template <typename Return, typename Guard, typename ArgsConverter, typename Func>
+    static auto call_guarded(ArgsConverter &&args_converter,
+                             Func f,
+                             const detail::function_record &rec,
+                             std::true_type /* guard_takes_record */)
+        -> decltype(std::move(args_converter).template call<Return, Guard>(f, rec)) {
+        return std::move(args_converter).template call<Return, Guard>(f, rec);
+    }
+
 protected:
     /// Special internal constructor for functors, lambda functions, etc.
     template <typename Func, typename Return, typename... Args, typename... Extra>
@@ -583,6 +691,28 @@ protected:
                 sizeof...(Args), cast_in::args_pos >= 0, cast_in::has_kwargs),
             "The number of argument annotations does not match the number of function arguments");
 
+        /* The GIL can only be released around functions that don't take or return Python
+           objects, unless they have their own call guard. Constructors may access the Python
+           instance. Only functions which opted in, or were defined in a scope which opted in,
+           get the guard releasing it. */
+        constexpr bool can_release_gil
+            = std::is_same<extract_guard_t<Extra...>, void_type>::value
+              && !holds_python_objects<intrinsic_t<Return>>::value
+              && !any_of<holds_python_objects<intrinsic_t<Args>>...>::value
+              && !any_of<std::is_same<is_new_style_constructor, Extra>...>::value;
+        constexpr bool opts_in_release_gil
+            = any_of<std::is_same<release_gil_if_args_loaded, Extra>...>::value;
+        static_assert(can_release_gil || !opts_in_release_gil,
+                      "py::release_gil_if_args_loaded() cannot be used with functions taking "
+                      "or returning Python objects, constructors or with a py::call_guard");
+        // In a scope which opted in, functions which cannot release the GIL simply keep it
+        constexpr bool scope_releases_gil
+            = can_release_gil
+              && any_of<std::is_same<release_gil_if_args_loaded_scope<true>, Extra>...>::value;
+        using guard_t = conditional_t<opts_in_release_gil || scope_releases_gil,
+                                      gil_release_if_args_loaded_guard,
+                                      extract_guard_t<Extra...>>;
+
         /* Dispatch code which converts function arguments and performs the actual function call */
         rec->impl = [](function_call &call) -> handle {
             /* Invoke call policy pre-call hook */
@@ -595,8 +725,8 @@ protected:
 
             auto result = call_impl<Return,
                                     /* Function scope guard -- defaults to the compile-to-nothing
-                                       `void_type` */
-                                    extract_guard_t<Extra...>,
+                                       `void_type`, or the one releasing the GIL on request */
+                                    guard_t,
                                     cast_in>(call, detail::function_ref<Return(Args...)>(cap->f));
 
             /* Invoke call policy post-call hook */
@@ -611,6 +741,8 @@ protected:
                                                                       // we have a kw_only
         rec->has_args = cast_in::args_pos >= 0;
         rec->has_kwargs = cast_in::has_kwargs;
+        rec->can_release_gil = can_release_gil;
+        rec->release_gil = scope_releases_gil; // An explicit annotation below takes precedence
 
         /* Process any user-provided function attributes */
         process_attributes<Extra...>::init(extra..., rec);
@@ -672,8 +804,36 @@ protected:
             rec->data[1]
                 = const_cast<void *>(reinterpret_cast<const void *>(&typeid(FunctionType)));
         }
+
+        /* Functions annotated with py::direct_call() can be called with their exact C++
+           signature by the std::function caster, bypassing the dispatcher and the GIL. Whether
+           a capture holds Python objects can't be checked, hence the opt-in. */
+        constexpr bool has_direct_call = any_of<std::is_same<direct_call, Extra>...>::value;
+        static_assert(!has_direct_call
+                          || (!any_of<std::is_same<is_method, Extra>...>::value
+                              && std::is_same<extract_guard_t<Extra...>, void_type>::value
+                              && !holds_python_objects<intrinsic_t<Return>>::value
+                              && !any_of<holds_python_objects<intrinsic_t<Args>>...>::value),
+                      "py::direct_call() cannot be used with methods, with a py::call_guard or "
+                      "with functions taking or returning Python objects");
+        set_direct_call<capture, Return, Args...>(rec, bool_constant<has_direct_call>());
+    }
+
+    template <typename Capture, typename Return, typename... Args>
+    static void set_direct_call(detail::function_record *rec, std::true_type) {
+        using direct_call_t = Return (*)(const detail::function_record &, Args...);
+        direct_call_t call = [](const detail::function_record &r, Args... args) -> Return {
+            const auto *data = (sizeof(Capture) <= sizeof(r.data) ? &r.data : r.data[0]);
+            auto *cap = const_cast<Capture *>(reinterpret_cast<const Capture *>(data));
+            return cap->f(std::forward<Args>(args)...);
+        };
+        rec->direct_call = reinterpret_cast<void (*)()>(call);
+        rec->direct_call_type = &typeid(Return (*)(Args...));
     }
 
+    template <typename Capture, typename Return, typename... Args>
+    static void set_direct_call(detail::function_record *, std::false_type) {}
+
     // Utility class that keeps track of all duplicated strings, and cleans them up in its
     // destructor, unless they are released. Basically a RAII-solution to deal with exceptions
     // along the way.
@@ -726,6 +886,12 @@ protected:
         for (auto &a : rec->args) {
             if (a.name) {
                 a.name = guarded_strdup(a.name);
+                // Interned once here, so that the dispatcher can match keyword arguments by
+                // pointer comparisons with the (usually interned) keyword names of a call
+                a.name_str = PyUnicode_InternFromString(a.name);
+                if (!a.name_str) {
+                    throw error_already_set();
+                }
             }
             if (a.descr) {
                 a.descr = guarded_strdup(a.descr);
@@ -736,6 +902,9 @@ protected:
 
         rec->is_constructor = (std::strcmp(rec->name, "__init__") == 0)
                               || (std::strcmp(rec->name, "__setstate__") == 0);
+        if (rec->is_constructor) {
+            rec->release_gil = false; // Old-style constructors access the Python instance
+        }
 
 #if defined(PYBIND11_DETAILED_ERROR_MESSAGES) && !defined(PYBIND11_DISABLE_NEW_STYLE_INIT_WARNING)
         if (rec->is_constructor && !rec->is_new_style_constructor) {
@@ -767,6 +936,27 @@ protected:
         rec->args.shrink_to_fit();
         rec->nargs = static_cast<std::uint16_t>(args);
 
+        /* Precompute the argument slot map used by the dispatcher for calls that don't pass any
+           keyword arguments. Functions taking py::args or py::kwargs always use the general
+           matching logic. */
+        if (!rec->has_args && !rec->has_kwargs) {
+            rec->call_plan.reserve(rec->nargs);
+            for (size_t i = 0; i < rec->nargs; ++i) {
+                if (i < rec->args.size()) {
+                    const auto &arg_rec = rec->args[i];
+                    rec->call_plan.emplace_back(arg_rec.value, arg_rec.convert, arg_rec.none);
+                } else {
+                    rec->call_plan.emplace_back(handle(), /*convert=*/true, /*none=*/true);
+                }
+            }
+            size_t min_args = rec->nargs;
+            while (min_args > 0 && rec->call_plan[min_args - 1].value) {
+                --min_args;
+            }
+            rec->call_plan_min_args = static_cast<std::uint16_t>(min_args);
+            rec->has_call_plan = true;
+        }
+
         if (rec->sibling && PYBIND11_INSTANCE_METHOD_CHECK(rec->sibling.ptr())) {
             rec->sibling = PYBIND11_INSTANCE_METHOD_GET_FUNCTION(rec->sibling.ptr());
         }
@@ -853,6 +1043,19 @@ protected:
             }
         }
 
+        /* The overload cache lives on the first overload of the chain and is enabled if any
+           overload requested it. Adding an overload invalidates previously cached results. */
+        bool use_overload_cache = false;
+        for (auto *it = chain_start; it != nullptr; it = it->next) {
+            use_overload_cache |= it->use_overload_cache;
+            it->overload_cache.reset();
+        }
+#if !defined(Py_GIL_DISABLED)
+        if (use_overload_cache) {
+            chain_start->overload_cache.reset(new detail::overload_type_cache());
+        }
+#endif
+
         std::string signatures;
         int index = 0;
         /* Create a nice pydoc rec including all signatures and
@@ -944,6 +1147,7 @@ protected:
             }
             for (auto &arg : rec->args) {
                 arg.value.dec_ref();
+                arg.name_str.dec_ref();
             }
             if (rec->def) {
                 std::free(const_cast<char *>(rec->def->ml_doc));
@@ -1012,7 +1216,36 @@ protected:
             const bool overloaded
                 = current_overload != nullptr && current_overload->next != nullptr;
 
-            for (; current_overload != nullptr; current_overload = current_overload->next) {
+            // If enabled, first try the overload that most recently succeeded without conversions
+            // for the same positional argument types. On failure, fall back to regular overload
+            // resolution.
+            overload_type_cache *const ocache = overloads->overload_cache.get();
+            const bool use_ocache = ocache != nullptr && overloaded && !kwnames_in
+                                    && n_args_in <= overload_type_cache::max_args;
+            if (use_ocache) {
+                if (const auto *hit = ocache->find(args_in_arr, n_args_in)) {
+                    // Copy out: the entry may be replaced by a reentrant call.
+                    const function_record &func = *hit->overload;
+                    function_call call(func, parent);
+                    if (load_args_from_call_plan(
+                            call, args_in_arr, n_args_in, self_value_and_holder)) {
+                        call.args_convert
+                            = args_convert_vector<arg_vector_small_size>(func.nargs, false);
+                        try {
+                            loader_life_support guard{};
+                            result = call_overload_impl(call);
+                        } catch (reference_cast_error &) {
+                            result = PYBIND11_TRY_NEXT_OVERLOAD;
+                        }
+                        if (result.ptr() != PYBIND11_TRY_NEXT_OVERLOAD) {
+                            current_overload = &func; // Also skips the loop below
+                        }
+                    }
+                }
+            }
+
+            for (; current_overload != nullptr && result.ptr() == PYBIND11_TRY_NEXT_OVERLOAD;
+                 current_overload = current_overload->next) {
 
                 /* For each overload:
                    1. Copy all positional arguments we were given, also checking to make sure that
@@ -1057,6 +1290,22 @@ protected:
                 // Protect std::min with parentheses
                 size_t args_to_copy = (std::min) (pos_args, n_args_in);
                 size_t args_copied = 0;
+                // Declared up front so the fast path below can jump past steps 0-4
+                size_t positional_args_copied = 0;
+                bool bad_arg = false;
+                small_vector<bool, arg_vector_small_size> used_kwargs(
+                    kwnames_in ? static_cast<size_t>(PyTuple_GET_SIZE(kwnames_in)) : 0, false);
+                size_t used_kwargs_count = 0;
+
+                if (!kwnames_in && func.has_call_plan) {
+                    // Fast path: without keyword arguments, steps 0-4 below reduce to filling the
+                    // slots from the precomputed call plan.
+                    if (!load_args_from_call_plan(
+                            call, args_in_arr, n_args_in, self_value_and_holder)) {
+                        continue;
+                    }
+                    goto args_loaded;
+                }
 
                 // 0. Inject new-style `self` argument
                 if (func.is_new_style_constructor) {
@@ -1073,7 +1322,6 @@ protected:
                 }
 
                 // 1. Copy any position arguments given.
-                bool bad_arg = false;
                 for (; args_copied < args_to_copy; ++args_copied) {
                     const argument_record *arg_rec
                         = args_copied < func.args.size() ? &func.args[args_copied] : nullptr;
@@ -1083,8 +1331,8 @@ protected:
                     example, the call site is: foo(0, key=1) but our overload is foo(key:int) then
                     this call can't be for us, because it would be invalid.
                     */
-                    if (kwnames_in && arg_rec && arg_rec->name
-                        && keyword_index(kwnames_in, arg_rec->name) >= 0) {
+                    if (kwnames_in && arg_rec && arg_rec->name_str
+                        && keyword_index(kwnames_in, arg_rec->name_str) >= 0) {
                         bad_arg = true;
                         break;
                     }
@@ -1104,7 +1352,7 @@ protected:
 
                 // Keep track of how many position args we copied out in case we need to come back
                 // to copy the rest into a py::args argument.
-                size_t positional_args_copied = args_copied;
+                positional_args_copied = args_copied;
 
                 // 1.5. Fill in any missing pos_only args from defaults if they exist
                 if (args_copied < func.nargs_pos_only) {
@@ -1124,16 +1372,15 @@ protected:
                 }
 
                 // 2. Check kwargs and, failing that, defaults that may help complete the list
-                small_vector<bool, arg_vector_small_size> used_kwargs(
-                    kwnames_in ? static_cast<size_t>(PyTuple_GET_SIZE(kwnames_in)) : 0, false);
-                size_t used_kwargs_count = 0;
                 if (args_copied < num_args) {
                     for (; args_copied < num_args; ++args_copied) {
                         const auto &arg_rec = func.args[args_copied];
 
                         handle value;
-                        if (kwnames_in && arg_rec.name) {
-                            ssize_t i = keyword_index(kwnames_in, arg_rec.name);
+                        // Once all keyword arguments are used, the remaining arguments can
+                        // only come from their defaults
+                        if (arg_rec.name_str && used_kwargs_count < used_kwargs.size()) {
+                            ssize_t i = keyword_index(kwnames_in, arg_rec.name_str);
                             if (i >= 0) {
                                 value = args_in_arr[n_args_in + static_cast<size_t>(i)];
                                 used_kwargs.set(static_cast<size_t>(i), true);
@@ -1210,6 +1457,7 @@ protected:
                     call.kwargs_ref = std::move(kwargs);
                 }
 
+            args_loaded:
                 // 5. Put everything in a vector.  Not technically step 5, we've been building it
                 // in `call.args` all along.
 
@@ -1233,12 +1481,17 @@ protected:
                 // 6. Call the function.
                 try {
                     loader_life_support guard{};
-                    result = func.impl(call);
+                    result = call_overload_impl(call);
                 } catch (reference_cast_error &) {
                     result = PYBIND11_TRY_NEXT_OVERLOAD;
                 }
 
                 if (result.ptr() != PYBIND11_TRY_NEXT_OVERLOAD) {
+                    // Only no-conversion matches are cached: a conversion-pass match would shadow
+                    // overloads that accept other values of the same types without conversion.
+                    if (use_ocache && result && func.has_call_plan) {
+                        ocache->insert(args_in_arr, n_args_in, &func);
+                    }
                     break;
                 }
 
@@ -1264,7 +1517,7 @@ protected:
                 for (auto &call : second_pass) {
                     try {
                         loader_life_support guard{};
-                        result = call.func.impl(call);
+                        result = call_overload_impl(call);
                     } catch (reference_cast_error &) {
                         result = PYBIND11_TRY_NEXT_OVERLOAD;
                     }
@@ -1409,22 +1662,56 @@ protected:
         return result.ptr();
     }
 
-    static ssize_t keyword_index(PyObject *haystack, char const *needle) {
-        /* kwargs is usually very small (<= 5 entries).  The arg strings are typically interned.
-         * CPython itself implements the search this way, first comparing all pointers ... which is
-         * cheap and will work if the strings are interned.  If it fails, then it falls back to a
-         * second lexicographic check. This is wildly expensive for huge argument lists, but those
-         * are incredibly rare so we optimize for the vastly common case of just a couple of args.
+    /// Fills `call.args` and `call.args_convert` from `function_record::call_plan` for a call
+    /// without keyword arguments. Returns false if the call cannot match this overload.
+    static bool load_args_from_call_plan(detail::function_call &call,
+                                         PyObject *const *args_in_arr,
+                                         size_t n_args_in,
+                                         detail::value_and_holder &self_value_and_holder) {
+        const detail::function_record &func = call.func;
+        size_t i = 0;
+        if (func.is_new_style_constructor) {
+            // See step 0 in `dispatcher`.
+            if (self_value_and_holder) {
+                self_value_and_holder.type->dealloc(self_value_and_holder);
+            }
+            call.init_self = args_in_arr[0];
+            call.args.emplace_back(reinterpret_cast<PyObject *>(&self_value_and_holder));
+            call.args_convert.push_back(false);
+            ++i;
+        }
+        if (n_args_in < func.call_plan_min_args) {
+            return false; // Not enough positional arguments, and no defaults for the rest
+        }
+        for (; i < func.nargs; ++i) {
+            const auto &slot = func.call_plan[i];
+            handle value = i < n_args_in ? handle(args_in_arr[i]) : slot.value;
+            if (!slot.none && value.is_none()) {
+                return false;
+            }
+            call.args.push_back(value);
+            call.args_convert.push_back(slot.convert);
+        }
+        return true;
+    }
+
+    static ssize_t keyword_index(PyObject *haystack, handle needle) {
+        /* kwargs is usually very small (<= 5 entries).  The arg strings are interned when the
+         * function is created, and the keyword names of a call typically are as well (they come
+         * from code object constants).  CPython itself implements the search this way, first
+         * comparing all pointers ... which is cheap and will work if the strings are interned.
+         * If it fails, then it falls back to a second lexicographic check. This is wildly
+         * expensive for huge argument lists, but those are incredibly rare so we optimize for
+         * the vastly common case of just a couple of args.
          */
         auto n = PyTuple_GET_SIZE(haystack);
-        auto s = reinterpret_steal<pybind11::str>(PyUnicode_InternFromString(needle));
         for (ssize_t i = 0; i < n; ++i) {
-            if (PyTuple_GET_ITEM(haystack, i) == s.ptr()) {
+            if (PyTuple_GET_ITEM(haystack, i) == needle.ptr()) {
                 return i;
             }
         }
         for (ssize_t i = 0; i < n; ++i) {
-            if (PyUnicode_Compare(PyTuple_GET_ITEM(haystack, i), s.ptr()) == 0) {
+            if (PyUnicode_Compare(PyTuple_GET_ITEM(haystack, i), needle.ptr()) == 0) {
                 return i;
             }
         }
@@ -1625,6 +1912,8 @@ inline slots_array init_slots(int (*exec_fn)(PyObject *), Options &&...options)
 PYBIND11_NAMESPACE_END(detail)
 
 /// Wrapper for Python extension modules
+class module_releasing_gil;
+
 class module_ : public object {
 public:
     PYBIND11_OBJECT_DEFAULT(module_, object, PyModule_Check)
@@ -1654,6 +1943,17 @@ public:
         return *this;
     }
 
+    /** \rst
+        Returns a wrapper of this module whose ``def()`` makes the functions release the GIL
+        while the C++ function runs, like ``py::release_gil_if_args_loaded()`` given on each of
+        them (functions which cannot release the GIL keep it):
+
+        .. code-block:: cpp
+
+            m.release_gil_if_args_loaded().def("solve", &solve).def("step", &step);
+    \endrst */
+    module_releasing_gil release_gil_if_args_loaded();
+
     /** \rst
         Create and return a new Python submodule with the given name and docstring.
         This also works recursively, i.e.
@@ -1776,6 +2076,28 @@ public:
     }
 };
 
+/// Module wrapper returned by module_::release_gil_if_args_loaded()
+class module_releasing_gil {
+public:
+    explicit module_releasing_gil(module_ m) : m(std::move(m)) {}
+
+    template <typename Func, typename... Extra>
+    module_releasing_gil &def(const char *name_, Func &&f, const Extra &...extra) {
+        m.def(name_,
+              std::forward<Func>(f),
+              extra...,
+              detail::release_gil_if_args_loaded_scope<true>());
+        return *this;
+    }
+
+private:
+    module_ m;
+};
+
+inline module_releasing_gil module_::release_gil_if_args_loaded() {
+    return module_releasing_gil(*this);
+}
+
 PYBIND11_NAMESPACE_BEGIN(detail)
 
 template <>
@@ -1839,6 +2161,10 @@ protected:
         tinfo->simple_type = true;
         tinfo->simple_ancestors = true;
         tinfo->module_local = rec.module_local;
+#if PYBIND11_INTERNALS_VERSION >= 13
+        tinfo->no_instance_tracking = rec.no_instance_tracking;
+        tinfo->thread_local_override_guard = rec.thread_local_override_guard;
+#endif
         tinfo->holder_enum_v = rec.holder_enum_v;
 
         with_internals([&](internals &internals) {
@@ -1847,10 +2173,16 @@ protected:
             auto &local_internals = get_local_internals();
             if (rec.module_local) {
                 local_internals.registered_types_cpp[rec.type] = tinfo;
+#ifdef Py_GIL_DISABLED
+                local_internals.registered_types_cpp_lock_free.store(rec.type, tinfo);
+#endif
             } else {
                 internals.registered_types_cpp[tindex] = tinfo;
 #if PYBIND11_INTERNALS_VERSION >= 12
                 internals.registered_types_cpp_fast[rec.type] = tinfo;
+#endif
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+                internals.registered_types_cpp_lock_free.register_type(*rec.type, tinfo);
 #endif
             }
 
@@ -1864,6 +2196,9 @@ protected:
 #endif
             internals.registered_types_py[reinterpret_cast<PyTypeObject *>(m_ptr)] = {tinfo};
             PYBIND11_WARNING_POP
+#if PYBIND11_INTERNALS_VERSION >= 13
+            internals.type_registry_generation.fetch_add(1, std::memory_order_release);
+#endif
         });
 
         if (rec.bases.size() > 1 || rec.multiple_inheritance) {
@@ -1879,6 +2214,18 @@ protected:
             parent_tinfo->simple_type = parent_tinfo->simple_type && parent_simple_ancestors;
         }
 
+#if PYBIND11_INTERNALS_VERSION >= 13
+        tinfo->inline_value_offset = inline_value_offset(rec);
+        if (tinfo->inline_value_offset != 0) {
+            tinfo->inline_copy_constructor = rec.inline_copy_constructor;
+            tinfo->inline_move_constructor = rec.inline_move_constructor;
+        }
+        if (rec.freelist_max_size > 0 && instance_freelist_supported(tinfo->type)) {
+            tinfo->freelist.reset(new instance_freelist());
+            tinfo->freelist->max_size = rec.freelist_max_size;
+        }
+#endif
+
         if (rec.module_local) {
             // Stash the local typeinfo and loader so that external modules can access it.
             tinfo->module_local_load = &type_caster_generic::local_load;
@@ -1941,6 +2288,43 @@ void set_operator_new(type_record *r) {
 template <typename>
 void set_operator_new(...) {}
 
+/// Copy and move constructors into the inline value storage of an instance (py::inline_value).
+/// Like type_caster_base::make_copy_constructor(), they are only available when T is copy/move
+/// constructible.
+using inline_value_constructor = void (*)(void *, const void *);
+
+template <typename T, typename = enable_if_t<is_copy_constructible<T>::value>>
+auto make_inline_copy_constructor(const T *)
+    -> decltype(new T(std::declval<const T>()), inline_value_constructor{}) {
+    return [](void *storage, const void *src) {
+        ::new (storage) T(*reinterpret_cast<const T *>(src));
+    };
+}
+
+template <typename T, typename = enable_if_t<is_move_constructible<T>::value>>
+auto make_inline_move_constructor(const T *)
+    -> decltype(new T(std::declval<T &&>()), inline_value_constructor{}) {
+    return [](void *storage, const void *src) {
+        ::new (storage) T(std::move(*const_cast<T *>(reinterpret_cast<const T *>(src))));
+    };
+}
+
+inline inline_value_constructor make_inline_copy_constructor(...) { return nullptr; }
+inline inline_value_constructor make_inline_move_constructor(...) { return nullptr; }
+
+/// Destroys a value stored inside its Python object, see class_::dealloc_impl()
+template <typename T, enable_if_t<std::is_destructible<T>::value, int> = 0>
+void destroy_inline_value(T *value) {
+    value->~T();
+}
+
+// Unreachable: py::inline_value() requires the holder std::unique_ptr<T>, which needs a public
+// destructor
+template <typename T, enable_if_t<!std::is_destructible<T>::value, int> = 0>
+void destroy_inline_value(T *) {
+    pybind11_fail("destroy_inline_value(): type is not destructible");
+}
+
 template <typename T, typename SFINAE = void>
 struct has_operator_delete : std::false_type {};
 template <typename T>
@@ -2320,7 +2704,14 @@ class class_ : public detail::generic_type {
     using is_base = detail::is_strict_base_of<T, type_>;
     // struct instead of using here to help MSVC:
     template <typename T>
-    struct is_valid_class_option : detail::any_of<is_holder<T>, is_subtype<T>, is_base<T>> {};
+    struct is_valid_class_option
+        : detail::any_of<is_holder<T>,
+                         is_subtype<T>,
+                         is_base<T>,
+                         std::is_same<T, release_gil_if_args_loaded>> {};
+    // Added to the functions defined with def() and def_static(), see release_gil_if_args_loaded
+    using release_gil_scope = detail::release_gil_if_args_loaded_scope<
+        detail::any_of<std::is_same<options, release_gil_if_args_loaded>...>::value>;
 
 public:
     using type = type_;
@@ -2363,6 +2754,17 @@ public:
                  none_of<std::is_same<multiple_inheritance, Extra>...>::value),
             "Error: multiple inheritance bases must be specified via class_ template options");
 
+        // Overrides look up the Python object of `this` in the registry of live instances
+        static_assert(!has_alias || none_of<std::is_same<no_instance_tracking, Extra>...>::value,
+                      "py::no_instance_tracking() cannot be used with an alias class (aka "
+                      "trampoline)");
+        static_assert(!has_alias || none_of<std::is_same<inline_value, Extra>...>::value,
+                      "py::inline_value() cannot be used with an alias class (aka trampoline)");
+        // Inline values are owned by the Python object, so the holder must never be needed
+        static_assert(none_of<std::is_same<inline_value, Extra>...>::value
+                          || std::is_same<holder_type, std::unique_ptr<type>>::value,
+                      "py::inline_value() requires the holder type std::unique_ptr<T>");
+
         type_record record;
         record.scope = scope;
         record.name = name;
@@ -2383,6 +2785,8 @@ public:
         }
 
         set_operator_new<type>(&record);
+        record.inline_copy_constructor = make_inline_copy_constructor((const type *) nullptr);
+        record.inline_move_constructor = make_inline_move_constructor((const type *) nullptr);
 
         /* Register base classes specified via template arguments to class_, if any */
         PYBIND11_EXPAND_SIDE_EFFECTS(add_base<options>(record));
@@ -2412,16 +2816,27 @@ public:
             with_internals([&](internals &internals) {
                 auto &local_internals = get_local_internals();
                 if (record.module_local) {
-                    local_internals.registered_types_cpp[&typeid(type_alias)]
-                        = local_internals.registered_types_cpp[&typeid(type)];
+                    type_info *const val = local_internals.registered_types_cpp[&typeid(type)];
+                    local_internals.registered_types_cpp[&typeid(type_alias)] = val;
+#ifdef Py_GIL_DISABLED
+                    local_internals.registered_types_cpp_lock_free.store(&typeid(type_alias),
+                                                                         val);
+#endif
                 } else {
                     type_info *const val
                         = internals.registered_types_cpp[std::type_index(typeid(type))];
                     internals.registered_types_cpp[std::type_index(typeid(type_alias))] = val;
 #if PYBIND11_INTERNALS_VERSION >= 12
                     internals.registered_types_cpp_fast[&typeid(type_alias)] = val;
+#endif
+#if defined(Py_GIL_DISABLED) && PYBIND11_INTERNALS_VERSION >= 13
+                    internals.registered_types_cpp_lock_free.register_type(typeid(type_alias),
+                                                                           val);
 #endif
                 }
+#if PYBIND11_INTERNALS_VERSION >= 13
+                internals.type_registry_generation.fetch_add(1, std::memory_order_release);
+#endif
             });
         }
         def("_pybind11_conduit_v1_", cpp_conduit_method);
@@ -2450,7 +2865,8 @@ public:
                         name(name_),
                         is_method(*this),
                         sibling(getattr(*this, name_, none())),
-                        extra...);
+                        extra...,
+                        release_gil_scope());
         add_class_method(*this, name_, cf);
         return *this;
     }
@@ -2463,7 +2879,8 @@ public:
                         name(name_),
                         scope(*this),
                         sibling(getattr(*this, name_, none())),
-                        extra...);
+                        extra...,
+                        release_gil_scope());
         auto cf_name = cf.name();
         attr(std::move(cf_name)) = staticmethod(std::move(cf));
         return *this;
@@ -2805,6 +3222,12 @@ private:
             register_instance(inst, v_h.value_ptr(), v_h.type);
             v_h.set_instance_registered();
         }
+        if (detail::value_is_inline(v_h)) {
+            // Owned by the Python object rather than by a holder (see dealloc_impl()), but
+            // flagged like any other initialized value
+            v_h.set_holder_constructed();
+            return;
+        }
         init_holder(inst, v_h, (const holder_type *) holder_ptr, v_h.value_ptr<type>());
     }
 
@@ -2875,7 +3298,10 @@ private:
     // throw `error_already_set` from the C++ destructor. This is forbidden and will
     // trigger std::terminate().
     static void dealloc_impl(detail::value_and_holder &v_h) {
-        if (v_h.holder_constructed()) {
+        if (detail::value_is_inline(v_h)) {
+            detail::destroy_inline_value(v_h.value_ptr<type>());
+            v_h.set_holder_constructed(false);
+        } else if (v_h.holder_constructed()) {
             v_h.holder<holder_type>().~holder_type();
             v_h.set_holder_constructed(false);
         } else {
@@ -3396,16 +3822,7 @@ all_type_info_get_cache(PyTypeObject *type) {
         weakref(reinterpret_cast<PyObject *>(type), cpp_function([type](handle wr) {
                     with_internals([type](internals &internals) {
                         internals.registered_types_py.erase(type);
-
-                        // TODO consolidate the erasure code in pybind11_meta_dealloc() in class.h
-                        auto &cache = internals.inactive_override_cache;
-                        for (auto it = cache.begin(), last = cache.end(); it != last;) {
-                            if (it->first == reinterpret_cast<PyObject *>(type)) {
-                                it = cache.erase(it);
-                            } else {
-                                ++it;
-                            }
-                        }
+                        erase_override_caches(internals, reinterpret_cast<PyObject *>(type));
                     });
 
                     wr.dec_ref();
@@ -3612,6 +4029,73 @@ typing::Iterator<ValueType> make_value_iterator(Type &value, Extra &&...extra) {
         std::begin(value), std::end(value), std::forward<Extra>(extra)...);
 }
 
+/** \rst
+    Enables (or disables) recording the durations of calls of the functions of this extension
+    module which release the GIL, or could release it, with ``py::release_gil_if_args_loaded()``.
+    The durations include the conversion of the arguments and of the result.
+    See :func:`call_profile`.
+\endrst */
+inline void enable_call_profiling(bool enable = true) {
+    detail::call_profiling_enabled().store(enable, std::memory_order_relaxed);
+}
+
+/** \rst
+    Returns the call durations recorded for the bound function ``func`` (all of its overloads)
+    while call profiling was enabled, as a dict with the keys ``calls``, ``histogram`` (the number
+    of calls which took between 2**i and 2**(i+1) nanoseconds, for each i), ``median_ns`` (the
+    lower bound of the bucket of the median), ``releases_gil`` and ``recommend_release_gil``. The
+    latter is true if the GIL could be released, isn't and the median call takes at least
+    ``min_median_ns``: a candidate for ``py::release_gil_if_args_loaded()``.
+\endrst */
+inline dict call_profile(handle func, std::uint64_t min_median_ns = 10000) {
+    handle h = detail::get_function(func);
+    detail::function_record *rec = nullptr;
+    if (h && PyCFunction_Check(h.ptr())) {
+        rec = detail::function_record_ptr_from_PyObject(PyCFunction_GET_SELF(h.ptr()));
+    }
+    if (rec == nullptr) {
+        throw type_error("call_profile(): not a function bound with pybind11");
+    }
+
+    std::uint64_t counts[detail::call_duration_histogram::num_buckets] = {};
+    bool can_release_gil = false;
+    bool releases_gil = false;
+    for (; rec != nullptr; rec = rec->next) {
+        can_release_gil = can_release_gil || rec->can_release_gil;
+        releases_gil = releases_gil || rec->release_gil;
+        if (auto *histogram = rec->call_durations.load(std::memory_order_acquire)) {
+            for (size_t i = 0; i < detail::call_duration_histogram::num_buckets; ++i) {
+                counts[i] += histogram->buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::uint64_t calls = 0;
+    list histogram;
+    for (auto count : counts) {
+        calls += count;
+        histogram.append(count);
+    }
+    std::uint64_t median_ns = 0;
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < detail::call_duration_histogram::num_buckets && calls != 0; ++i) {
+        seen += counts[i];
+        if (2 * seen >= calls) {
+            median_ns = i == 0 ? 0 : std::uint64_t{1} << i;
+            break;
+        }
+    }
+
+    dict result;
+    result["calls"] = calls;
+    result["histogram"] = histogram;
+    result["median_ns"] = median_ns;
+    result["releases_gil"] = releases_gil;
+    result["recommend_release_gil"]
+        = can_release_gil && !releases_gil && calls != 0 && median_ns >= min_median_ns;
+    return result;
+}
+
 template <typename InputType, typename OutputType>
 void implicitly_convertible() {
     struct set_flag {
@@ -3803,13 +4287,152 @@ inline const char *error_already_set::what() const noexcept {
 
 PYBIND11_NAMESPACE_BEGIN(detail)
 
+/// Marks the Python override of a virtual function as running for an object on the current
+/// thread, while PYBIND11_OVERRIDE calls it. For types bound with
+/// py::thread_local_override_guard(), get_type_override() uses these marks instead of frame
+/// inspection to detect that the override calls back into the C++ function (e.g. through the
+/// base class implementation), which must then not be dispatched to Python again.
+class override_call_marker {
+public:
+    override_call_marker(const void *this_ptr, const char *name)
+        : this_ptr(this_ptr), name(name), previous(top()) {
+        top() = this;
+    }
+    ~override_call_marker() { top() = previous; }
+    override_call_marker(const override_call_marker &) = delete;
+    override_call_marker &operator=(const override_call_marker &) = delete;
+
+    /// Is the override `name` running for the object at `this_ptr` on the current thread?
+    static bool is_active(const void *this_ptr, const char *name) {
+        for (const auto *marker = top(); marker != nullptr; marker = marker->previous) {
+            if (marker->this_ptr == this_ptr
+                && (marker->name == name || std::strcmp(marker->name, name) == 0)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    // See type_info_thread_cache::thread_instance()
+    PYBIND11_NOINLINE static override_call_marker *&top() {
+        static thread_local override_call_marker *marker = nullptr;
+        return marker;
+    }
+
+    const void *this_ptr;
+    const char *name;
+    override_call_marker *previous;
+};
+
+#if PYBIND11_INTERNALS_VERSION >= 13 && defined(PYBIND11_HAS_OVERRIDE_TABLES)
+/// The version tag of `type`, or 0 if it has none (e.g. because the type was just modified)
+inline unsigned int valid_type_version_tag(PyTypeObject *type) {
+#    if PY_VERSION_HEX >= 0x030D0000
+    // Py_TPFLAGS_VALID_VERSION_TAG is no longer maintained; a tag of 0 is invalid
+    return type->tp_version_tag;
+#    else
+    return PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG) ? type->tp_version_tag : 0;
+#    endif
+}
+
+/// Looks up `name` in the override table of `type`. Returns false if it isn't in the table (or
+/// the table is outdated); otherwise `name_str` is set to the interned name if `type` overrides
+/// `name` in Python, and left empty if it doesn't.
+inline bool find_override_table_entry(PyTypeObject *type, const char *name, handle &name_str) {
+    return with_internals([&](internals &internals) {
+        auto &table = internals.override_tables[reinterpret_cast<PyObject *>(type)];
+        auto version_tag = valid_type_version_tag(type);
+        if (table.version_tag != version_tag || version_tag == 0) {
+            table.clear();
+            return false;
+        }
+        for (const auto &entry : table.entries) {
+            if (entry.name == name) {
+                if (entry.overridden) {
+                    name_str = entry.name_str;
+                }
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+/// Adds `name` to the override table of `type`, unless the type was modified in the meantime.
+inline void add_override_table_entry(PyTypeObject *type,
+                                     unsigned int version_tag,
+                                     const char *name,
+                                     str name_str,
+                                     bool overridden) {
+    with_internals([&](internals &internals) {
+        auto &table = internals.override_tables[reinterpret_cast<PyObject *>(type)];
+        if (version_tag == 0 || version_tag != valid_type_version_tag(type)) {
+            return;
+        }
+        if (table.version_tag != version_tag) {
+            table.clear();
+            table.version_tag = version_tag;
+        }
+        for (const auto &entry : table.entries) {
+            if (entry.name == name) {
+                return; // Added concurrently by another thread
+            }
+        }
+        table.entries.push_back({name, name_str.release().ptr(), overridden});
+    });
+}
+#endif
+
 inline function
 get_type_override(const void *this_ptr, const type_info *this_type, const char *name) {
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (this_type->thread_local_override_guard
+        && override_call_marker::is_active(this_ptr, name)) {
+        return function();
+    }
+#endif
     handle self = get_object_handle(this_ptr, this_type);
     if (!self) {
         return function();
     }
     handle type = type::handle_of(self);
+
+#if PYBIND11_INTERNALS_VERSION >= 13 && defined(PYBIND11_HAS_OVERRIDE_TABLES)
+    /* The attributes of each Python type are looked up once per name and kept in a table until
+       the type is modified, so that virtual functions that aren't overridden in Python cost no
+       Python attribute lookup at all, and overridden ones no conversion of `name` */
+    auto *type_ptr = reinterpret_cast<PyTypeObject *>(type.ptr());
+    handle cached_name;
+    function override;
+    if (find_override_table_entry(type_ptr, name, cached_name)) {
+        if (!cached_name) {
+            return function();
+        }
+        override = getattr(self, cached_name, function());
+        if (override.is_cpp_function()) {
+            // Shadowed by an instance attribute
+            return function();
+        }
+    } else {
+        auto name_str = reinterpret_steal<str>(PyUnicode_InternFromString(name));
+        if (!name_str) {
+            throw error_already_set();
+        }
+#    if PY_VERSION_HEX >= 0x030C0000
+        PyUnstable_Type_AssignVersionTag(type_ptr);
+#    endif
+        // Read before the lookup, so that the entry is dropped if the lookup modifies the type
+        auto version_tag = valid_type_version_tag(type_ptr);
+        override = getattr(self, name_str, function());
+        bool overridden = override && !override.is_cpp_function();
+        add_override_table_entry(
+            type_ptr, version_tag, name, std::move(name_str), overridden);
+        if (!overridden) {
+            return function();
+        }
+    }
+#else
     auto key = std::make_pair(type.ptr(), name);
 
     /* Cache functions that aren't overridden in Python to avoid
@@ -3829,6 +4452,13 @@ get_type_override(const void *this_ptr, const type_info *this_type, const char *
         });
         return function();
     }
+#endif
+
+#if PYBIND11_INTERNALS_VERSION >= 13
+    if (this_type->thread_local_override_guard) {
+        return override; // Recursion was ruled out above
+    }
+#endif
 
     /* Don't call dispatch code if invoked from overridden function.
        Unfortunately this doesn't work on PyPy and GraalPy. */
@@ -3917,6 +4547,8 @@ function get_override(const T *this_ptr, const char *name) {
         pybind11::function override                                                               \
             = pybind11::get_override(static_cast<const cname *>(this), name);                     \
         if (override) {                                                                           \
+            pybind11::detail::override_call_marker marker(static_cast<const cname *>(this),       \
+                                                          name);                                  \
             auto o = override(__VA_ARGS__);                                                       \
             PYBIND11_WARNING_PUSH                                                                 \
             PYBIND11_WARNING_DISABLE_MSVC(4127)                                                   \
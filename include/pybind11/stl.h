@@ -16,6 +16,7 @@
 
 #include <deque>
 #include <initializer_list>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -295,14 +296,152 @@ public:
                              + const_name("]"));
 };
 
+template <typename Value>
+bool integer_fits(long long v) {
+    using limits = std::numeric_limits<Value>;
+    if (std::is_signed<Value>::value) {
+        return v >= static_cast<long long>(limits::min())
+               && v <= static_cast<long long>(limits::max());
+    }
+    return v >= 0
+           && static_cast<unsigned long long>(v)
+                  <= static_cast<unsigned long long>(limits::max());
+}
+
+// Reads an exact `int` (for integers) or `float` (for floating-point numbers) without going
+// through the general conversion logic. Anything else, including integers which don't fit, is
+// left to the regular `type_caster`.
+template <typename Value, enable_if_t<std::is_integral<Value>::value, int> = 0>
+bool load_exact_number(handle src, Value &out) {
+    if (!PyLong_CheckExact(src.ptr())) {
+        return false;
+    }
+    int overflow = 0;
+    const long long v = PyLong_AsLongLongAndOverflow(src.ptr(), &overflow);
+    if (overflow != 0 || !integer_fits<Value>(v)) {
+        return false;
+    }
+    out = static_cast<Value>(v);
+    return true;
+}
+
+template <typename Value, enable_if_t<std::is_floating_point<Value>::value, int> = 0>
+bool load_exact_number(handle src, Value &out) {
+    if (!PyFloat_CheckExact(src.ptr())) {
+        return false;
+    }
+    out = static_cast<Value>(PyFloat_AS_DOUBLE(src.ptr()));
+    return true;
+}
+
+// Caster for the elements of sequence containers, with a shortcut for plain numbers
+template <typename Value, typename SFINAE = void>
+struct element_caster : make_caster<Value> {};
+
+template <typename Value>
+struct element_caster<Value, enable_if_t<is_bulk_copyable<Value>::value>> : make_caster<Value> {
+    bool load(handle src, bool convert) {
+        return load_exact_number(src, this->value) || make_caster<Value>::load(src, convert);
+    }
+};
+
+// Containers which can be returned as a lazy sequence (see `return_value_policy::lazy_sequence`)
+template <typename Type>
+struct is_lazy_sequence_container : std::false_type {};
+
+template <typename T, typename Alloc>
+struct is_lazy_sequence_container<std::vector<T, Alloc>>
+    : bool_constant<!std::is_same<T, bool>::value && is_copy_constructible<T>::value> {};
+
+// Python sequence which owns a vector and only converts its elements when they are accessed
+template <typename Vector>
+struct lazy_sequence_state {
+    Vector items;
+};
+
+template <typename State>
+class_<State> lazy_sequence_class(std::true_type /* is_bulk_copyable */) {
+    using T = typename decltype(State::items)::value_type;
+    class_<State> cl(handle(), "lazy_sequence", pybind11::module_local(), buffer_protocol());
+    cl.def_buffer([](State &s) -> buffer_info {
+        return buffer_info(s.items.data(),
+                           static_cast<ssize_t>(sizeof(T)),
+                           format_descriptor<T>::format(),
+                           1,
+                           {static_cast<ssize_t>(s.items.size())},
+                           {static_cast<ssize_t>(sizeof(T))},
+                           /* readonly = */ true);
+    });
+    return cl;
+}
+
+template <typename State>
+class_<State> lazy_sequence_class(std::false_type /* is_bulk_copyable */) {
+    return class_<State>(handle(), "lazy_sequence", pybind11::module_local());
+}
+
+template <typename Vector>
+void register_lazy_sequence() {
+    using State = lazy_sequence_state<Vector>;
+    using T = typename Vector::value_type;
+    using SizeType = typename Vector::size_type;
+    using DiffType = typename Vector::difference_type;
+
+    // See make_iterator_impl
+#if PY_VERSION_HEX >= 0x030E00C1 // 3.14.0rc1
+    PYBIND11_LOCK_INTERNALS(get_internals());
+#endif
+    if (get_type_info(typeid(State), false)) {
+        return;
+    }
+    auto cl = lazy_sequence_class<State>(is_bulk_copyable<T>());
+    cl.def("__len__", [](const State &s) { return s.items.size(); });
+    cl.def(
+        "__getitem__",
+        [](const State &s, DiffType i) -> const T & {
+            const auto n = static_cast<DiffType>(s.items.size());
+            if (i < 0) {
+                i += n;
+            }
+            if (i < 0 || i >= n) {
+                throw index_error();
+            }
+            return s.items[static_cast<SizeType>(i)];
+        },
+        return_value_policy::copy);
+    cl.def("__getitem__", [](const State &s, const slice &slice) -> State * {
+        size_t start = 0, stop = 0, step = 0, slicelength = 0;
+        if (!slice.compute(s.items.size(), &start, &stop, &step, &slicelength)) {
+            throw error_already_set();
+        }
+        auto *seq = new State();
+        seq->items.reserve(slicelength);
+        for (size_t i = 0; i < slicelength; ++i) {
+            seq->items.push_back(s.items[start]);
+            start += step;
+        }
+        return seq;
+    });
+    cl.def(
+        "__iter__",
+        [](const State &s) {
+            return make_iterator<return_value_policy::copy>(s.items.begin(), s.items.end());
+        },
+        keep_alive<0, 1>());
+}
+
 template <typename Type, typename Value>
 struct list_caster {
     using value_conv = make_caster<Value>;
+    using element_conv = element_caster<Value>;
 
     bool load(handle src, bool convert) {
         if (!object_is_convertible_to_std_vector(src)) {
             return false;
         }
+        if (load_buffer(src, is_bulk_copyable<Value>())) {
+            return true;
+        }
         if (isinstance<sequence>(src)) {
             return convert_elements(src, convert);
         }
@@ -318,6 +457,21 @@ struct list_caster {
     }
 
 private:
+    bool load_buffer(handle src, std::true_type /* is_bulk_copyable */) {
+        matching_1d_buffer<Value> buf(src);
+        if (!buf) {
+            return false;
+        }
+        if (buf.contiguous()) {
+            value.assign(buf.data(), buf.data() + buf.size());
+        } else {
+            value.resize(buf.size());
+            buf.copy_to(value.begin());
+        }
+        return true;
+    }
+    bool load_buffer(handle, std::false_type /* is_bulk_copyable */) { return false; }
+
     template <typename T = Type, enable_if_t<has_reserve_method<T>::value, int> = 0>
     void reserve_maybe(const sequence &s, Type *) {
         value.reserve(s.size());
@@ -328,19 +482,54 @@ private:
         auto s = reinterpret_borrow<sequence>(seq);
         value.clear();
         reserve_maybe(s, &value);
+        if (is_exact_list_or_tuple(seq)) {
+            // The size is checked on every iteration since converting an element can resize a
+            // list, like the iterator would
+            for (ssize_t i = 0; i < list_or_tuple_size(seq); ++i) {
+                object item = list_or_tuple_item(seq, i);
+                if (!item || !load_element(item, convert)) {
+                    return false;
+                }
+            }
+            return true;
+        }
         for (const auto &it : seq) {
-            value_conv conv;
-            if (!conv.load(it, convert)) {
+            if (!load_element(it, convert)) {
                 return false;
             }
-            value.push_back(cast_op<Value &&>(std::move(conv)));
         }
         return true;
     }
 
+    bool load_element(handle src, bool convert) {
+        element_conv conv;
+        if (!conv.load(src, convert)) {
+            return false;
+        }
+        value.push_back(cast_op<Value &&>(std::move(conv)));
+        return true;
+    }
+
+    template <typename T>
+    static handle cast_lazy_sequence(T &&src, handle, std::true_type) {
+        register_lazy_sequence<Type>();
+        return make_caster<lazy_sequence_state<Type>>::cast(
+            lazy_sequence_state<Type>{std::forward<T>(src)}, return_value_policy::move, handle());
+    }
+    template <typename T>
+    static handle cast_lazy_sequence(T &&src, handle parent, std::false_type) {
+        return cast(std::forward<T>(src), return_value_policy::automatic, parent);
+    }
+
 public:
+    static constexpr bool supports_lazy_sequence = is_lazy_sequence_container<Type>::value;
+
     template <typename T>
     static handle cast(T &&src, return_value_policy policy, handle parent) {
+        if (policy == return_value_policy::lazy_sequence) {
+            return cast_lazy_sequence(
+                std::forward<T>(src), parent, bool_constant<supports_lazy_sequence>());
+        }
         if (!std::is_lvalue_reference<T>::value) {
             policy = return_value_policy_override<Value>::policy(policy);
         }
@@ -385,6 +574,7 @@ ArrayType vector_to_array(V &&v) {
 template <typename ArrayType, typename Value, bool Resizable, size_t Size = 0>
 struct array_caster {
     using value_conv = make_caster<Value>;
+    using element_conv = element_caster<Value>;
 
 private:
     std::unique_ptr<ArrayType> value;
@@ -397,10 +587,23 @@ private:
         // For the `resize` to work, `Value` must be default constructible.
         // For `std::valarray`, this is a requirement:
         // https://en.cppreference.com/w/cpp/named_req/NumericType
+        if (is_exact_list_or_tuple(seq)) {
+            const ssize_t size = list_or_tuple_size(seq);
+            value->resize(static_cast<size_t>(size));
+            for (ssize_t i = 0; i < size; ++i) {
+                object item = list_or_tuple_item(seq, i);
+                element_conv conv;
+                if (!item || !conv.load(item, convert)) {
+                    return false;
+                }
+                (*value)[static_cast<size_t>(i)] = cast_op<Value &&>(std::move(conv));
+            }
+            return true;
+        }
         value->resize(l.size());
         size_t ctr = 0;
         for (const auto &it : l) {
-            value_conv conv;
+            element_conv conv;
             if (!conv.load(it, convert)) {
                 return false;
             }
@@ -411,8 +614,9 @@ private:
 
     template <bool R = Resizable, enable_if_t<!R, int> = 0>
     bool convert_elements(handle seq, bool convert) {
+        const bool list_or_tuple = is_exact_list_or_tuple(seq);
         auto l = reinterpret_borrow<sequence>(seq);
-        if (l.size() != Size) {
+        if ((list_or_tuple ? static_cast<size_t>(list_or_tuple_size(seq)) : l.size()) != Size) {
             return false;
         }
         // The `temp` storage is needed to support `Value` types that are not
@@ -421,23 +625,61 @@ private:
         // because the compile time overhead for the specializations is deemed
         // more significant than the runtime overhead for the `temp` storage.
         std::vector<Value> temp;
-        temp.reserve(l.size());
-        for (auto it : l) {
-            value_conv conv;
-            if (!conv.load(it, convert)) {
-                return false;
+        temp.reserve(Size);
+        if (list_or_tuple) {
+            for (ssize_t i = 0; i < static_cast<ssize_t>(Size); ++i) {
+                object item = list_or_tuple_item(seq, i);
+                element_conv conv;
+                if (!item || !conv.load(item, convert)) {
+                    return false;
+                }
+                temp.emplace_back(cast_op<Value &&>(std::move(conv)));
+            }
+        } else {
+            for (auto it : l) {
+                element_conv conv;
+                if (!conv.load(it, convert)) {
+                    return false;
+                }
+                temp.emplace_back(cast_op<Value &&>(std::move(conv)));
             }
-            temp.emplace_back(cast_op<Value &&>(std::move(conv)));
         }
         value.reset(new ArrayType(vector_to_array<ArrayType, Size>(std::move(temp))));
         return true;
     }
 
+    bool load_buffer(handle src, std::true_type /* is_bulk_copyable */) {
+        matching_1d_buffer<Value> buf(src);
+        return buf && copy_elements(buf);
+    }
+    bool load_buffer(handle, std::false_type /* is_bulk_copyable */) { return false; }
+
+    template <bool R = Resizable, enable_if_t<R, int> = 0>
+    bool copy_elements(const matching_1d_buffer<Value> &buf) {
+        value.reset(new ArrayType{});
+        value->resize(buf.size());
+        buf.copy_to(std::begin(*value));
+        return true;
+    }
+
+    template <bool R = Resizable, enable_if_t<!R, int> = 0>
+    bool copy_elements(const matching_1d_buffer<Value> &buf) {
+        if (buf.size() != Size) {
+            return false;
+        }
+        value.reset(new ArrayType{});
+        buf.copy_to(value->begin());
+        return true;
+    }
+
 public:
     bool load(handle src, bool convert) {
         if (!object_is_convertible_to_std_vector(src)) {
             return false;
         }
+        if (load_buffer(src, is_bulk_copyable<Value>())) {
+            return true;
+        }
         if (isinstance<sequence>(src)) {
             return convert_elements(src, convert);
         }
@@ -15,7 +15,11 @@
 #include "operators.h"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
@@ -123,6 +127,67 @@ void vector_if_equal_operator(enable_if_t<is_comparable<Vector>::value, Class_>
         "Return true the container contains ``x``");
 }
 
+// Appends the items of a buffer, which may be a view of `v` itself (if it is bound with
+// py::buffer_protocol()). That one has to be copied first since appending can reallocate.
+template <typename Vector>
+void append_1d_buffer(Vector &v, const matching_1d_buffer<typename Vector::value_type> &buf) {
+    using T = typename Vector::value_type;
+    const T *data = v.empty() ? nullptr : &v[0];
+    const std::less<const T *> less;
+    if (data != nullptr && !less(buf.data(), data) && less(buf.data(), data + v.size())) {
+        Vector copy;
+        append_1d_buffer(copy, buf);
+        v.insert(v.end(), copy.begin(), copy.end());
+        return;
+    }
+    if (buf.contiguous()) {
+        v.insert(v.end(), buf.data(), buf.data() + buf.size());
+        return;
+    }
+    v.reserve(v.size() + buf.size());
+    buf.copy_to(std::back_inserter(v));
+}
+
+template <typename Vector>
+bool vector_append_buffer(Vector &v, handle src, std::true_type /* is_bulk_copyable */) {
+    matching_1d_buffer<typename Vector::value_type> buf(src);
+    if (!buf) {
+        return false;
+    }
+    append_1d_buffer(v, buf);
+    return true;
+}
+
+template <typename Vector>
+bool vector_append_buffer(Vector &, handle, std::false_type /* is_bulk_copyable */) {
+    return false;
+}
+
+// Slice assignment from any buffer, e.g. `v[a:b] = numpy_array`, copying matching buffers directly
+template <typename Vector, typename Class_, typename AssignSlice>
+void vector_assign_slice_from_buffer(Class_ &cl,
+                                     AssignSlice assign_slice,
+                                     std::true_type /* is_bulk_copyable */) {
+    using T = typename Vector::value_type;
+    cl.def(
+        "__setitem__",
+        [assign_slice](Vector &v, const slice &slice, const buffer &value) {
+            Vector items;
+            if (!vector_append_buffer(items, value, std::true_type())) {
+                for (handle h : value) {
+                    items.push_back(h.cast<T>());
+                }
+            }
+            assign_slice(v, slice, items);
+        },
+        "Assign list elements from a buffer using a slice object");
+}
+
+template <typename Vector, typename Class_, typename AssignSlice>
+void vector_assign_slice_from_buffer(Class_ &,
+                                     AssignSlice,
+                                     std::false_type /* is_bulk_copyable */) {}
+
 // Vector modifiers -- requires a copyable vector_type:
 // (Technically, some of these (pop and __delitem__) don't actually require copyability, but it
 // seems silly to allow deletion but not insertion, so include them here too.)
@@ -151,6 +216,9 @@ void vector_modifiers(
 
     cl.def(init([](const iterable &it) {
         auto v = std::unique_ptr<Vector>(new Vector());
+        if (vector_append_buffer(*v, it, is_bulk_copyable<typename Vector::value_type>())) {
+            return v.release();
+        }
         v->reserve(len_hint(it));
         for (handle h : it) {
             v->push_back(h.cast<T>());
@@ -169,6 +237,9 @@ void vector_modifiers(
     cl.def(
         "extend",
         [](Vector &v, const iterable &it) {
+            if (vector_append_buffer(v, it, is_bulk_copyable<typename Vector::value_type>())) {
+                return;
+            }
             const size_t old_size = v.size();
             v.reserve(old_size + len_hint(it));
             try {
@@ -255,25 +326,26 @@ void vector_modifiers(
         arg("s"),
         "Retrieve list elements using a slice object");
 
-    cl.def(
-        "__setitem__",
-        [](Vector &v, const slice &slice, const Vector &value) {
-            size_t start = 0, stop = 0, step = 0, slicelength = 0;
-            if (!slice.compute(v.size(), &start, &stop, &step, &slicelength)) {
-                throw error_already_set();
-            }
+    auto assign_slice = [](Vector &v, const slice &slice, const Vector &value) {
+        size_t start = 0, stop = 0, step = 0, slicelength = 0;
+        if (!slice.compute(v.size(), &start, &stop, &step, &slicelength)) {
+            throw error_already_set();
+        }
 
-            if (slicelength != value.size()) {
-                throw std::runtime_error(
-                    "Left and right hand size of slice assignment have different sizes!");
-            }
+        if (slicelength != value.size()) {
+            throw std::runtime_error(
+                "Left and right hand size of slice assignment have different sizes!");
+        }
 
-            for (size_t i = 0; i < slicelength; ++i) {
-                v[start] = value[i];
-                start += step;
-            }
-        },
-        "Assign list elements using a slice object");
+        for (size_t i = 0; i < slicelength; ++i) {
+            v[start] = value[i];
+            start += step;
+        }
+    };
+
+    cl.def("__setitem__", assign_slice, "Assign list elements using a slice object");
+
+    vector_assign_slice_from_buffer<Vector>(cl, assign_slice, is_bulk_copyable<typename Vector::value_type>());
 
     cl.def(
         "__delitem__",
@@ -423,6 +495,19 @@ struct vector_has_data_and_format<
                                       std::declval<Vector>().data()),
                              typename Vector::value_type *>::value>> : std::true_type {};
 
+// Throws a `type_error` unless `buf` is a one-dimensional buffer of `T`s to be copied into a
+// `target` container
+template <typename T>
+void require_1d_buffer(const matching_1d_buffer<T> &buf, const char *target) {
+    if (buf.ndim() != 1) {
+        throw type_error(std::string("Only valid 1D buffers can be copied to a ") + target);
+    }
+    if (!buf) {
+        throw type_error("Format mismatch (Python: " + std::string(buf.format())
+                         + " C++: " + format_descriptor<T>::format() + ")");
+    }
+}
+
 // [workaround(intel)] Separate function required here
 // Workaround as the Intel compiler does not compile the enable_if_t part below
 // (tested with icc (ICC) 2021.1 Beta 20200827)
@@ -654,6 +739,116 @@ auto map_if_insertion_operator(Class_ &cl, std::string const &name)
         "Return the canonical string representation of this map.");
 }
 
+template <typename T, typename = void>
+struct has_format_descriptor : std::false_type {};
+template <typename T>
+struct has_format_descriptor<T, void_t<decltype(format_descriptor<T>::format())>>
+    : std::true_type {};
+
+// Bulk export and import of keys and values is provided if both have a buffer format (i.e. they
+// are arithmetic or registered with PYBIND11_NUMPY_DTYPE) and values can be assigned
+template <typename Map>
+using map_has_formats = bool_constant<has_format_descriptor<typename Map::key_type>::value
+                                      && has_format_descriptor<typename Map::mapped_type>::value
+                                      && is_copy_assignable<typename Map::mapped_type>::value>;
+
+// Contiguous copy of the keys or values of a map, which only exposes the (read-only) buffer
+// protocol, e.g. for `numpy.asarray()` or `memoryview`
+template <typename T>
+struct map_array {
+    explicit map_array(size_t size) : items(new T[size]), size(size) {}
+    std::unique_ptr<T[]> items;
+    size_t size;
+};
+
+template <typename T>
+object cast_map_array(map_array<T> &&array) {
+    using Array = map_array<T>;
+    // See make_iterator_impl
+#if PY_VERSION_HEX >= 0x030E00C1 // 3.14.0rc1
+    PYBIND11_LOCK_INTERNALS(get_internals());
+#endif
+    if (!get_type_info(typeid(Array), false)) {
+        class_<Array>(handle(), "map_array", pybind11::module_local(), buffer_protocol())
+            .def("__len__", [](const Array &a) { return a.size; })
+            .def_buffer([](Array &a) -> buffer_info {
+                return buffer_info(a.items.get(),
+                                   static_cast<ssize_t>(sizeof(T)),
+                                   format_descriptor<T>::format(),
+                                   1,
+                                   {a.size},
+                                   {sizeof(T)},
+                                   /* readonly = */ true);
+            });
+    }
+    return cast(std::move(array));
+}
+
+template <typename Map>
+auto map_reserve(Map &m, size_t size, int) -> decltype(m.reserve(size), void()) {
+    m.reserve(size);
+}
+template <typename Map>
+void map_reserve(Map &, size_t, long) {}
+
+template <typename Map, typename Class_>
+void map_arrays(Class_ &cl, std::true_type) {
+    using KeyType = typename Map::key_type;
+    using MappedType = typename Map::mapped_type;
+
+    cl.def(
+        "keys_array",
+        [](const Map &m) {
+            map_array<KeyType> keys(m.size());
+            size_t i = 0;
+            for (const auto &kv : m) {
+                keys.items[i++] = kv.first;
+            }
+            return cast_map_array(std::move(keys));
+        },
+        "Return a copy of the keys as a one-dimensional buffer");
+
+    cl.def(
+        "values_array",
+        [](const Map &m) {
+            map_array<MappedType> values(m.size());
+            size_t i = 0;
+            for (const auto &kv : m) {
+                values.items[i++] = kv.second;
+            }
+            return cast_map_array(std::move(values));
+        },
+        "Return a copy of the values, in the order of keys_array(), as a one-dimensional "
+        "buffer");
+
+    cl.def(
+        "update_from_arrays",
+        [](Map &m, const buffer &keys, const buffer &values) {
+            matching_1d_buffer<KeyType> key_buf(keys);
+            matching_1d_buffer<MappedType> value_buf(values);
+            require_1d_buffer(key_buf, "map");
+            require_1d_buffer(value_buf, "map");
+            if (key_buf.size() != value_buf.size()) {
+                throw value_error("keys and values must have the same length");
+            }
+            map_reserve(m, m.size() + key_buf.size(), 0);
+            for (size_t i = 0; i < key_buf.size(); ++i) {
+                auto it = m.find(key_buf[i]);
+                if (it != m.end()) {
+                    it->second = value_buf[i];
+                } else {
+                    m.emplace(key_buf[i], value_buf[i]);
+                }
+            }
+        },
+        arg("keys"),
+        arg("values"),
+        "Insert or assign the items given by two one-dimensional buffers of equal length");
+}
+
+template <typename Map, typename Class_>
+void map_arrays(Class_ &, std::false_type) {}
+
 struct keys_view {
     virtual size_t len() = 0;
     virtual iterator iter() = 0;
@@ -850,6 +1045,9 @@ class_<Map, holder_type> bind_map(handle scope, const std::string &name, Args &&
     // Assignment provided only if the type is copyable
     detail::map_assignment<Map, Class_>(cl);
 
+    // Bulk conversion from and to buffers, provided only if both types have a buffer format
+    detail::map_arrays<Map>(cl, detail::map_has_formats<Map>());
+
     cl.def("__delitem__", [](Map &m, const KeyType &k) {
         auto it = m.find(k);
         if (it == m.end()) {
@@ -189,16 +189,16 @@ public:
         // Internals always exists in the subinterpreter, this class enforces it when it creates
         // the subinterpreter. Even if it didn't, this only creates the pointer-to-pointer, not the
         // internals themselves.
-        detail::get_internals_pp_manager().get_pp();
-        detail::get_local_internals_pp_manager().get_pp();
+        auto *internals_pp = detail::get_internals_pp_manager().get_pp();
+        auto *local_internals_pp = detail::get_local_internals_pp_manager().get_pp();
 
         // End it
         Py_EndInterpreter(destroy_tstate);
 
         // It's possible for the  internals to be created during endinterpreter (e.g. if a
         // py::capsule calls `get_internals()` during destruction), so we destroy afterward.
-        detail::get_internals_pp_manager().destroy();
-        detail::get_local_internals_pp_manager().destroy();
+        detail::get_internals_pp_manager().destroy(internals_pp);
+        detail::get_local_internals_pp_manager().destroy(local_internals_pp);
 
         // switch back to the old tstate and old GIL (if there was one)
         if (switch_back) {
@@ -0,0 +1,401 @@
+"""Runtime microbenchmarks for the pybind11 hot paths.
+
+Each benchmark times a small Python snippet calling into the ``pybind11_benchmarks``
+module and reports the time per operation. Results can be written as JSON and compared
+against a previous run to catch performance regressions:
+
+    python bench.py --json new.json --compare old.json --threshold 0.1
+
+The exit code is 1 if any benchmark got slower than the threshold allows.
+"""
+
+from __future__ import annotations
+
+import argparse
+import dataclasses
+import json
+import platform
+import re
+import sys
+import threading
+import timeit
+from typing import Any, Callable
+
+import pybind11_benchmarks as m
+
+
+@dataclasses.dataclass
+class Benchmark:
+    name: str
+    # Returns the zero-argument callable to be timed
+    setup: Callable[[], Callable[[], Any]]
+    # Number of operations performed by one invocation of the timed callable
+    ops: int = 1
+    # Optional module that must be importable (e.g. numpy)
+    requires: str | None = None
+
+
+BENCHMARKS: list[Benchmark] = []
+
+
+def benchmark(name: str, ops: int = 1, requires: str | None = None):
+    def decorator(setup):
+        BENCHMARKS.append(Benchmark(name, setup, ops, requires))
+        return setup
+
+    return decorator
+
+
+# Function call dispatch
+
+
+@benchmark("call_noargs")
+def _():
+    return m.noop
+
+
+@benchmark("call_one_arg")
+def _():
+    return lambda: m.identity(1)
+
+
+@benchmark("call_defaults")
+def _():
+    return lambda: m.kwargs(1)
+
+
+@benchmark("call_kwargs")
+def _():
+    return lambda: m.kwargs(a=1, b=2, c=3, d=4)
+
+
+@benchmark("call_many_kwargs")
+def _():
+    return lambda: m.many_kwargs(j=1, i=2, h=3, g=4, f=5, e=6, d=7, c=8, b=9, a=10)
+
+
+@benchmark("overload_fallthrough")
+def _():
+    return lambda: m.overloaded(1)
+
+
+# Bound class instances
+
+
+@benchmark("instance_create_destroy")
+def _():
+    return lambda: m.Point(1.0, 2.0)
+
+
+@benchmark("instance_default_create_destroy")
+def _():
+    return m.Point
+
+
+@benchmark("instance_create_destroy_10000", ops=10000)
+def _():
+    # Keeps many instances registered at the same time
+    point = m.Point
+    return lambda: [point() for _ in range(10000)]
+
+
+@benchmark("instance_return_by_value")
+def _():
+    return lambda: m.make_point(1.0, 2.0)
+
+
+@benchmark("untracked_instance_create_destroy")
+def _():
+    return lambda: m.UntrackedPoint(1.0, 2.0)
+
+
+@benchmark("untracked_instance_return_by_value")
+def _():
+    return lambda: m.make_untracked_point(1.0, 2.0)
+
+
+@benchmark("recycled_instance_create_destroy")
+def _():
+    return lambda: m.RecycledPoint(1.0, 2.0)
+
+
+@benchmark("recycled_instance_return_by_value")
+def _():
+    return lambda: m.make_recycled_point(1.0, 2.0)
+
+
+@benchmark("inline_instance_create_destroy")
+def _():
+    return lambda: m.InlinePoint(1.0, 2.0)
+
+
+@benchmark("inline_instance_return_by_value")
+def _():
+    return lambda: m.make_inline_point(1.0, 2.0)
+
+
+@benchmark("load_inline_instance")
+def _():
+    p = m.InlinePoint(1.0, 2.0)
+    return lambda: m.inline_point_x(p)
+
+
+@benchmark("load_bound_instance")
+def _():
+    p = m.Point(1.0, 2.0)
+    return lambda: m.point_x(p)
+
+
+# Thread scaling of bound instance conversions. The time per operation is the wall time divided
+# by the number of operations of all threads: on free-threaded builds, it should decrease in
+# proportion to the number of threads (up to the number of cores).
+
+
+def run_in_threads(threads: int, iterations: int) -> Callable[[], None]:
+    def worker():
+        p = m.Point(1.0, 2.0)
+        point_x = m.point_x
+        make_point = m.make_point
+        for _ in range(iterations):
+            point_x(make_point(p.x, p.y))
+
+    def run():
+        workers = [threading.Thread(target=worker) for _ in range(threads)]
+        for w in workers:
+            w.start()
+        for w in workers:
+            w.join()
+
+    return run
+
+
+THREAD_ITERATIONS = 10000
+
+for _threads in (1, 2, 4, 8, 16, 32):
+    benchmark(f"type_lookup_threads_{_threads}", ops=_threads * THREAD_ITERATIONS)(
+        lambda threads=_threads: run_in_threads(threads, THREAD_ITERATIONS)
+    )
+
+
+# STL container conversions
+
+
+@benchmark("list_to_vector_1000", ops=1000)
+def _():
+    values = [float(i) for i in range(1000)]
+    return lambda: m.sum_vector(values)
+
+
+@benchmark("vector_to_list_1000", ops=1000)
+def _():
+    return lambda: m.make_vector(1000)
+
+
+@benchmark("dict_to_map_100", ops=100)
+def _():
+    values = {str(i): i for i in range(100)}
+    return lambda: m.sum_map(values)
+
+
+@benchmark("map_to_dict_100", ops=100)
+def _():
+    return lambda: m.make_map(100)
+
+
+# Virtual calls from C++
+
+
+@benchmark("virtual_call_not_overridden", ops=1000)
+def _():
+    animal = m.Animal()
+    return lambda: m.call_sound(animal, 1000)
+
+
+@benchmark("virtual_call_inherited", ops=1000)
+def _():
+    # Python subclass that doesn't override the virtual function
+    class Cat(m.Animal):
+        pass
+
+    cat = Cat()
+    return lambda: m.call_sound(cat, 1000)
+
+
+@benchmark("virtual_call_overridden", ops=1000)
+def _():
+    class Dog(m.Animal):
+        def sound(self, n):
+            return n + 1
+
+    dog = Dog()
+    return lambda: m.call_sound(dog, 1000)
+
+
+@benchmark("virtual_call_overridden_guarded", ops=1000)
+def _():
+    # Recursion into the override detected with py::thread_local_override_guard()
+    class Dog(m.GuardedAnimal):
+        def sound(self, n):
+            return n + 1
+
+    dog = Dog()
+    return lambda: m.call_sound(dog, 1000)
+
+
+# std::function callbacks called from C++
+
+
+@benchmark("callback_cpp_stateful", ops=1000)
+def _():
+    # Lambda with captures, called without going through Python
+    return lambda: m.call_callback(m.stateful_increment, 1000)
+
+
+@benchmark("callback_python", ops=1000)
+def _():
+    return lambda: m.call_callback(lambda i: i + 1, 1000)
+
+
+# Python functions called from C++
+
+
+@benchmark("call_python_positional", ops=1000)
+def _():
+    return lambda: m.call_python(lambda i: None, 1000)
+
+
+@benchmark("call_python_collected", ops=1000)
+def _():
+    # Same call through unpacking_collector, for comparison
+    return lambda: m.call_python_collected(lambda i: None, 1000)
+
+
+# NumPy vectorization
+
+
+@benchmark("vectorize_small", requires="numpy")
+def _():
+    import numpy as np
+
+    a = np.arange(10, dtype=float)
+    b = np.arange(10, dtype=float)
+    return lambda: m.vectorized(a, b)
+
+
+@benchmark("vectorize_10000", ops=10000, requires="numpy")
+def _():
+    import numpy as np
+
+    a = np.arange(10000, dtype=float)
+    b = np.arange(10000, dtype=float)
+    return lambda: m.vectorized(a, b)
+
+
+def is_available(module: str | None) -> bool:
+    if module is None:
+        return True
+    try:
+        __import__(module)
+    except ImportError:
+        return False
+    return True
+
+
+def run(bench: Benchmark, repeat: int, min_time: float) -> dict[str, Any]:
+    stmt = bench.setup()
+    timer = timeit.Timer(stmt)
+    number, elapsed = timer.autorange()
+    # Scale up so that each measurement takes at least `min_time` seconds
+    if elapsed < min_time:
+        number = max(number, int(number * min_time / max(elapsed, 1e-9)))
+    best = min(timer.repeat(repeat=repeat, number=number))
+    return {
+        "name": bench.name,
+        "ns_per_op": best / number / bench.ops * 1e9,
+        "number": number,
+        "ops": bench.ops,
+        "repeat": repeat,
+    }
+
+
+def compare(
+    results: list[dict[str, Any]], baseline_path: str, threshold: float
+) -> list[str]:
+    with open(baseline_path, encoding="utf-8") as f:
+        baseline = {b["name"]: b for b in json.load(f)["benchmarks"]}
+    regressions = []
+    print(f"\nComparison against {baseline_path} (threshold: {threshold:+.0%}):")
+    for result in results:
+        old = baseline.get(result["name"])
+        if old is None:
+            continue
+        change = result["ns_per_op"] / old["ns_per_op"] - 1.0
+        flag = ""
+        if change > threshold:
+            flag = "  <-- REGRESSION"
+            regressions.append(result["name"])
+        print(f"  {result['name']:<36} {change:+8.1%}{flag}")
+    return regressions
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--filter", help="only run benchmarks matching this regex")
+    parser.add_argument("--json", help="write results to this file")
+    parser.add_argument("--compare", help="compare against a previous JSON result")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="relative slowdown reported as a regression (default: 0.1)",
+    )
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument(
+        "--min-time",
+        type=float,
+        default=0.05,
+        help="minimum duration of a single measurement in seconds",
+    )
+    parser.add_argument("--list", action="store_true", help="list benchmarks and exit")
+    args = parser.parse_args(argv)
+
+    selected = [
+        b for b in BENCHMARKS if not args.filter or re.search(args.filter, b.name)
+    ]
+    if args.list:
+        for b in selected:
+            print(b.name)
+        return 0
+
+    results = []
+    for bench in selected:
+        if not is_available(bench.requires):
+            print(f"{bench.name:<36} skipped ({bench.requires} not available)")
+            continue
+        result = run(bench, args.repeat, args.min_time)
+        results.append(result)
+        print(f"{bench.name:<36} {result['ns_per_op']:12.1f} ns/op")
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(
+                {
+                    "python": sys.version,
+                    "implementation": platform.python_implementation(),
+                    "machine": platform.machine(),
+                    "benchmarks": results,
+                },
+                f,
+                indent=2,
+            )
+
+    if args.compare:
+        regressions = compare(results, args.compare, args.threshold)
+        if regressions:
+            print(f"\n{len(regressions)} regression(s): {', '.join(regressions)}")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,210 @@
+/*
+    tests/benchmarks/pybind11_benchmarks.cpp -- bindings exercised by the runtime
+    microbenchmarks in bench.py
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+struct Point {
+    Point() = default;
+    Point(double x, double y) : x(x), y(y) {}
+    double x = 0.0;
+    double y = 0.0;
+};
+
+struct UntrackedPoint {
+    UntrackedPoint() = default;
+    UntrackedPoint(double x, double y) : x(x), y(y) {}
+    double x = 0.0;
+    double y = 0.0;
+};
+
+struct RecycledPoint {
+    RecycledPoint() = default;
+    RecycledPoint(double x, double y) : x(x), y(y) {}
+    double x = 0.0;
+    double y = 0.0;
+};
+
+struct InlinePoint {
+    InlinePoint() = default;
+    InlinePoint(double x, double y) : x(x), y(y) {}
+    double x = 0.0;
+    double y = 0.0;
+};
+
+class Animal {
+public:
+    Animal() = default;
+    Animal(const Animal &) = default;
+    Animal &operator=(const Animal &) = default;
+    virtual ~Animal() = default;
+    virtual int sound(int n) const { return n; }
+};
+
+class PyAnimal : public Animal {
+public:
+    using Animal::Animal;
+    int sound(int n) const override { PYBIND11_OVERRIDE(int, Animal, sound, n); }
+};
+
+// Same as Animal, bound with py::thread_local_override_guard()
+class GuardedAnimal : public Animal {};
+
+class PyGuardedAnimal : public GuardedAnimal {
+public:
+    int sound(int n) const override { PYBIND11_OVERRIDE(int, GuardedAnimal, sound, n); }
+};
+
+// Calls a (possibly Python-overridden) virtual function `iterations` times from C++.
+int call_sound(const Animal &animal, int iterations) {
+    int total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        total += animal.sound(i);
+    }
+    return total;
+}
+
+} // namespace
+
+PYBIND11_MODULE(pybind11_benchmarks, m, py::mod_gil_not_used()) {
+    m.doc() = "pybind11 runtime microbenchmark module";
+
+    // Function call dispatch
+    m.def("noop", []() {});
+    m.def("identity", [](int i) { return i; });
+    m.def(
+        "kwargs",
+        [](int a, int b, int c, int d) { return a + b + c + d; },
+        py::arg("a"),
+        py::arg("b") = 0,
+        py::arg("c") = 0,
+        py::arg("d") = 0);
+    m.def(
+        "many_kwargs",
+        [](int a, int b, int c, int d, int e, int f, int g, int h, int i, int j) {
+            return a + b + c + d + e + f + g + h + i + j;
+        },
+        py::arg("a") = 0,
+        py::arg("b") = 0,
+        py::arg("c") = 0,
+        py::arg("d") = 0,
+        py::arg("e") = 0,
+        py::arg("f") = 0,
+        py::arg("g") = 0,
+        py::arg("h") = 0,
+        py::arg("i") = 0,
+        py::arg("j") = 0);
+
+    // Overload resolution: the matching overload for an `int` argument is the last one
+    m.def("overloaded", [](const std::string &) { return 0; });
+    m.def("overloaded", [](const py::bytes &) { return 1; });
+    m.def("overloaded", [](const Point &) { return 2; });
+    m.def("overloaded", [](const std::vector<int> &) { return 3; });
+    m.def("overloaded", [](const py::dict &) { return 4; });
+    m.def("overloaded", [](int) { return 5; });
+
+    // Bound class instances: creation, destruction and type_caster_generic::load_impl
+    py::class_<Point>(m, "Point")
+        .def(py::init<>())
+        .def(py::init<double, double>(), py::arg("x"), py::arg("y"))
+        .def_readwrite("x", &Point::x)
+        .def_readwrite("y", &Point::y);
+    m.def("point_x", [](const Point &p) { return p.x; });
+    m.def("make_point", [](double x, double y) { return Point(x, y); });
+
+    // Same as Point, without registering instances (py::no_instance_tracking)
+    py::class_<UntrackedPoint>(m, "UntrackedPoint", py::no_instance_tracking())
+        .def(py::init<>())
+        .def(py::init<double, double>(), py::arg("x"), py::arg("y"));
+    m.def("make_untracked_point", [](double x, double y) { return UntrackedPoint{x, y}; });
+
+    // Same as Point, reusing the storage of destroyed instances (py::freelist)
+    py::class_<RecycledPoint>(m, "RecycledPoint", py::freelist())
+        .def(py::init<>())
+        .def(py::init<double, double>(), py::arg("x"), py::arg("y"));
+    m.def("make_recycled_point", [](double x, double y) { return RecycledPoint{x, y}; });
+
+    // Same as Point, storing the C++ object inside the Python object (py::inline_value)
+    py::class_<InlinePoint>(m, "InlinePoint", py::inline_value())
+        .def(py::init<>())
+        .def(py::init<double, double>(), py::arg("x"), py::arg("y"))
+        .def_readwrite("x", &InlinePoint::x);
+    m.def("make_inline_point", [](double x, double y) { return InlinePoint{x, y}; });
+    m.def("inline_point_x", [](const InlinePoint &p) { return p.x; });
+
+    // STL container conversions
+    m.def("sum_vector", [](const std::vector<double> &v) {
+        double total = 0.0;
+        for (double d : v) {
+            total += d;
+        }
+        return total;
+    });
+    m.def("make_vector", [](std::size_t n) { return std::vector<double>(n, 1.0); });
+    m.def("sum_map", [](const std::map<std::string, int> &d) {
+        int total = 0;
+        for (const auto &kv : d) {
+            total += kv.second;
+        }
+        return total;
+    });
+    m.def("make_map", [](int n) {
+        std::map<std::string, int> d;
+        for (int i = 0; i < n; ++i) {
+            d.emplace(std::to_string(i), i);
+        }
+        return d;
+    });
+
+    // Virtual calls from C++ into (possibly) Python-derived classes
+    py::class_<Animal, PyAnimal>(m, "Animal").def(py::init<>()).def("sound", &Animal::sound);
+    py::class_<GuardedAnimal, Animal, PyGuardedAnimal>(
+        m, "GuardedAnimal", py::thread_local_override_guard())
+        .def(py::init<>());
+    m.def("call_sound", &call_sound, py::arg("animal"), py::arg("iterations"));
+
+    // C++ callbacks passed through Python as std::function
+    m.def("call_callback", [](const std::function<int(int)> &f, int iterations) {
+        int total = 0;
+        for (int i = 0; i < iterations; ++i) {
+            total += f(i);
+        }
+        return total;
+    });
+    int step = 1;
+    m.def("stateful_increment", [step](int i) { return i + step; }, py::direct_call());
+
+    // Calls of Python functions from C++ with positional arguments only, and the same calls
+    // through the general argument collector (used for keyword and unpacked arguments)
+    m.def("call_python", [](const py::function &f, int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            f(i);
+        }
+    });
+    m.def("call_python_collected", [](const py::function &f, int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            py::detail::collect_arguments<py::return_value_policy::automatic_reference>(i).call(
+                f.ptr());
+        }
+    });
+
+    // NumPy vectorization
+    m.def("vectorized", py::vectorize([](double a, double b) { return a * b; }));
+}
@@ -42,6 +42,7 @@ Cflags: -I${{includedir}}
 
 
 main_headers = {
+    "include/pybind11/asyncio.h",
     "include/pybind11/attr.h",
     "include/pybind11/buffer_info.h",
     "include/pybind11/cast.h",
@@ -7,8 +7,16 @@
     BSD-style license that can be found in the LICENSE file.
 */
 
+#include <pybind11/asyncio.h>
+
 #include "pybind11_tests.h"
 
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
 TEST_SUBMODULE(async_module, m) {
     struct DoesNotSupportAsync {};
     py::class_<DoesNotSupportAsync>(m, "DoesNotSupportAsync").def(py::init<>());
@@ -22,4 +30,40 @@ TEST_SUBMODULE(async_module, m) {
             f.attr("set_result")(5);
             return f.attr("__await__")();
         });
+
+    // test_awaitable
+    m.def("awaitable_from_thread", [](int x) {
+        py::awaitable<int> result;
+        std::thread([result, x]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            result.set_value(2 * x);
+        }).detach();
+        return result;
+    });
+    m.def("awaitable_ready", [](const std::string &s) {
+        py::awaitable<std::string> result;
+        result.set_value(s + "!");
+        return result;
+    });
+    m.def("awaitable_error", []() {
+        py::awaitable<void> result;
+        std::thread([result]() {
+            result.set_exception(std::make_exception_ptr(std::invalid_argument("async failure")));
+        }).detach();
+        return result;
+    });
+    m.def("awaitable_abandoned", []() { return py::awaitable<int>(); });
+
+    // test_std_future
+    m.def("future_int", [](int x) {
+        return std::async(std::launch::async, [x]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return x + 1;
+        });
+    });
+    m.def("future_void",
+          []() { return std::async(std::launch::async, []() { std::this_thread::yield(); }); });
+    m.def("future_error", []() {
+        return std::async(std::launch::async, []() -> int { throw std::runtime_error("boom"); });
+    });
 }
@@ -29,3 +29,49 @@ def test_await(event_loop):
 def test_await_missing(event_loop):
     with pytest.raises(TypeError):
         event_loop.run_until_complete(get_await_result(m.DoesNotSupportAsync()))
+
+
+async def gather(*xs):
+    return await asyncio.gather(*xs)
+
+
+def test_awaitable(event_loop):
+    async def run():
+        return await gather(m.awaitable_from_thread(21), m.awaitable_ready("done"))
+
+    assert event_loop.run_until_complete(run()) == [42, "done!"]
+
+    async def run_error():
+        return await m.awaitable_error()
+
+    with pytest.raises(ValueError, match="async failure"):
+        event_loop.run_until_complete(run_error())
+
+    async def run_abandoned():
+        return await m.awaitable_abandoned()
+
+    with pytest.raises(RuntimeError, match="destroyed without a result"):
+        event_loop.run_until_complete(run_abandoned())
+
+
+def test_awaitable_needs_running_loop():
+    with pytest.raises(RuntimeError, match="no running event loop"):
+        m.awaitable_ready("x")
+
+
+def test_std_future(event_loop):
+    async def run():
+        return await gather(m.future_int(1), m.future_void())
+
+    assert event_loop.run_until_complete(run()) == [2, None]
+
+    async def run_error():
+        return await m.future_error()
+
+    with pytest.raises(RuntimeError, match="boom"):
+        event_loop.run_until_complete(run_error())
+
+
+def test_awaitable_signature():
+    assert "-> asyncio.Future[int]" in m.awaitable_from_thread.__doc__
+    assert "-> asyncio.Future[None]" in m.future_void.__doc__
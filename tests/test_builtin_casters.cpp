@@ -226,6 +226,22 @@ TEST_SUBMODULE(builtin_casters, m) {
           []() { return py::str(TypeWithBothOperatorStringAndStringView()); });
 #endif
 
+    // test_bytes_view
+    m.def("bytes_view_roundtrip", [](py::bytes_view v) { return v; });
+    m.def("str_view_roundtrip", [](py::str_view v) { return v; });
+    m.def("str_view_size", [](py::str_view v) { return v.size(); });
+    // True if the view points into the buffer of `obj` instead of a copy
+    m.def("bytes_view_shares_memory", [](py::bytes_view v, const py::buffer &obj) {
+        return v.data() == obj.request().ptr;
+    });
+    m.def("str_view_shares_memory", [](py::str_view v, const py::str &obj) {
+        return v.data() == PyUnicode_AsUTF8(obj.ptr());
+    });
+    m.def("bytes_view_call", [](py::bytes_view v, const py::function &f) {
+        f();
+        return std::string(v);
+    });
+
     // test_integer_casting
     m.def("i32_str", [](std::int32_t v) { return std::to_string(v); });
     m.def("u32_str", [](std::uint32_t v) { return std::to_string(v); });
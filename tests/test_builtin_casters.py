@@ -224,6 +224,49 @@ def test_string_view(capture):
     assert m.str_from_type_with_both_operator_string_and_string_view() == "success"
 
 
+def test_bytes_view(doc, backport_typehints):
+    assert m.bytes_view_roundtrip(b"abc\x00def") == b"abc\x00def"
+    assert m.bytes_view_roundtrip(bytearray(b"xyz")) == b"xyz"
+    assert m.bytes_view_roundtrip(memoryview(b"0123456789")[2:5]) == b"234"
+    assert m.bytes_view_roundtrip(b"") == b""
+    with pytest.raises(TypeError):
+        m.bytes_view_roundtrip("str")
+    with pytest.raises(TypeError):
+        m.bytes_view_roundtrip(memoryview(b"0123456789")[::2])
+
+    payload = bytearray(1 << 20)
+    assert m.bytes_view_shares_memory(payload, payload)
+    data = b"0123"
+    assert m.bytes_view_shares_memory(data, data)
+
+    # The buffer stays exported while the function runs, so it cannot be resized
+    def resize():
+        with pytest.raises(BufferError):
+            payload.extend(b"more")
+
+    assert m.bytes_view_call(bytearray(b"abc"), lambda: None) == "abc"
+    payload = bytearray(b"abc")
+    assert m.bytes_view_call(payload, resize) == "abc"
+    payload.extend(b"def")
+    assert payload == b"abcdef"
+
+    assert (
+        backport_typehints(doc(m.bytes_view_roundtrip))
+        == "bytes_view_roundtrip(arg0: collections.abc.Buffer) -> bytes"
+    )
+
+
+def test_str_view(doc):
+    assert m.str_view_roundtrip("abc") == "abc"
+    assert m.str_view_roundtrip("\u00e9t\u00e9 \U0001f382") == "\u00e9t\u00e9 \U0001f382"
+    assert m.str_view_size("\u00e9") == 2
+    assert m.str_view_roundtrip(b"bytes") == "bytes"
+    assert m.str_view_roundtrip(bytearray(b"bytearray")) == "bytearray"
+    text = "x" * 1000
+    assert m.str_view_shares_memory(text, text)
+    assert doc(m.str_view_roundtrip) == "str_view_roundtrip(arg0: str) -> str"
+
+
 def test_integer_casting():
     """Issue #929 - out-of-range integer values shouldn't be accepted"""
     assert m.i32_str(-1) == "-1"
@@ -1,5 +1,5 @@
 /*
-    tests/test_call_policies.cpp -- keep_alive and call_guard
+    tests/test_call_policies.cpp -- keep_alive, call_guard and release_gil_if_args_loaded
 
     Copyright (c) 2016 Wenzel Jakob <wenzel.jakob@epfl.ch>
 
@@ -9,6 +9,12 @@
 
 #include "pybind11_tests.h"
 
+#include <array>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
 struct CustomGuard {
     static bool enabled;
 
@@ -109,5 +115,63 @@ TEST_SUBMODULE(call_policies, m) {
 
     m.def("with_gil", report_gil_status);
     m.def("without_gil", report_gil_status, py::call_guard<py::gil_scoped_release>());
+
+    // test_release_gil_if_args_loaded
+    m.def("released_gil", report_gil_status, py::release_gil_if_args_loaded());
+    struct GilReport {};
+    auto report_method = [report_gil_status](const GilReport &) { return report_gil_status(); };
+    py::class_<GilReport>(m, "GilReport")
+        .def(py::init<>())
+        .def("status", report_method, py::release_gil_if_args_loaded())
+        .def("status_with_gil", report_method, py::release_gil_if_args_loaded(false))
+        .def("status_unannotated", report_method);
+    m.def(
+        "released_gil_sum",
+        [report_gil_status](const std::pair<int, int> &p) {
+            return std::make_pair(p.first + p.second, report_gil_status());
+        },
+        py::release_gil_if_args_loaded());
+
+    // Class- and module-level opt-in, without annotating each function
+    struct ScopedGilReport {};
+    auto scoped_report_method
+        = [report_gil_status](const ScopedGilReport &) { return report_gil_status(); };
+    py::class_<ScopedGilReport, py::release_gil_if_args_loaded>(m, "ScopedGilReport")
+        .def(py::init<>())
+        .def("status", scoped_report_method)
+        .def("status_with_gil", scoped_report_method, py::release_gil_if_args_loaded(false))
+        .def_static("static_status", report_gil_status)
+        // Takes a Python object, so it keeps the GIL
+        .def("status_of",
+             [report_gil_status](const ScopedGilReport &, const py::object &) {
+                 return report_gil_status();
+             })
+        .def_property_readonly("status_property", scoped_report_method);
+
+    auto sm = m.def_submodule("release_gil");
+    sm.release_gil_if_args_loaded()
+        .def("status", report_gil_status)
+        .def("status_of", [report_gil_status](const py::object &) { return report_gil_status(); });
+    sm.def("status_unannotated", report_gil_status);
 #endif
+    // Python objects nested in other types cannot be accessed without the GIL either
+    static_assert(py::detail::holds_python_objects<std::vector<py::object>>::value, "");
+    static_assert(py::detail::holds_python_objects<py::typing::List<int>>::value, "");
+    static_assert(
+        py::detail::holds_python_objects<std::array<std::pair<int, py::handle>, 2>>::value, "");
+    static_assert(!py::detail::holds_python_objects<std::vector<std::pair<int, double>>>::value,
+                  "");
+
+    // test_call_profile
+    m.def("enable_call_profiling", &py::enable_call_profiling, py::arg("enable") = true);
+    m.def("call_profile",
+          &py::call_profile,
+          py::arg("func"),
+          py::arg("min_median_ns") = std::uint64_t{10000});
+    m.def("sleep_us", [](int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); });
+    m.def(
+        "sleep_us_released",
+        [](int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); },
+        py::release_gil_if_args_loaded());
+    m.def("takes_object", [](const py::object &) {});
 }
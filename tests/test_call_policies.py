@@ -254,3 +254,68 @@ def test_call_guard():
     if hasattr(m, "with_gil"):
         assert m.with_gil() == "GIL held"
         assert m.without_gil() == "GIL released"
+
+
+def test_release_gil_if_args_loaded():
+    if not hasattr(m, "with_gil"):
+        pytest.skip("Cannot check the GIL status")
+    assert m.released_gil() == "GIL released"
+
+    r = m.GilReport()
+    assert r.status() == "GIL released"
+    assert r.status_with_gil() == "GIL held"
+    # Only annotated functions release the GIL
+    assert r.status_unannotated() == "GIL held"
+
+    assert m.released_gil_sum((1, 2)) == (3, "GIL released")
+
+
+def test_release_gil_if_args_loaded_scope():
+    if not hasattr(m, "with_gil"):
+        pytest.skip("Cannot check the GIL status")
+    # py::class_<ScopedGilReport, py::release_gil_if_args_loaded>
+    r = m.ScopedGilReport()
+    assert r.status() == "GIL released"
+    assert r.status_with_gil() == "GIL held"
+    assert m.ScopedGilReport.static_status() == "GIL released"
+    # Functions taking Python objects and property accessors always hold the GIL
+    assert r.status_of(None) == "GIL held"
+    assert r.status_property == "GIL held"
+
+    # m.release_gil_if_args_loaded().def(...)
+    assert m.release_gil.status() == "GIL released"
+    assert m.release_gil.status_of(None) == "GIL held"
+    assert m.release_gil.status_unannotated() == "GIL held"
+
+
+def test_call_profile():
+    m.enable_call_profiling()
+    try:
+        for _ in range(5):
+            m.sleep_us(2000)
+            m.sleep_us_released(2000)
+            m.takes_object(None)
+    finally:
+        m.enable_call_profiling(False)
+    m.sleep_us(2000)  # Not recorded
+
+    p = m.call_profile(m.sleep_us)
+    assert p["calls"] == 5
+    assert sum(p["histogram"]) == 5
+    assert p["median_ns"] >= 1 << 20
+    assert not p["releases_gil"]
+    assert p["recommend_release_gil"]
+    assert not m.call_profile(m.sleep_us, min_median_ns=10**10)["recommend_release_gil"]
+
+    p = m.call_profile(m.sleep_us_released)
+    assert p["calls"] == 5
+    assert p["releases_gil"]
+    assert not p["recommend_release_gil"]
+
+    # Functions which cannot release the GIL are not profiled
+    p = m.call_profile(m.takes_object)
+    assert p["calls"] == 0
+    assert not p["recommend_release_gil"]
+
+    with pytest.raises(TypeError):
+        m.call_profile(len)
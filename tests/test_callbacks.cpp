@@ -108,6 +108,10 @@ TEST_SUBMODULE(callbacks, m) {
         f(234, "expected_name"_a = UnregisteredType(), "kw"_a = 567);
     });
 
+    // Positional arguments only
+    m.def("test_arg_conversion_error3",
+          [](const py::function &f) { f(234, "str", UnregisteredType()); });
+
     // test_lambda_closure_cleanup
     struct Payload {
         Payload() { print_default_created(this); }
@@ -196,6 +200,49 @@ TEST_SUBMODULE(callbacks, m) {
         return "argument does NOT match dummy_function. This should never happen!";
     });
 
+    // test_stateful_cpp_function_roundtrip
+    int offset = 10;
+    m.def("stateful_adder", [offset](int i) { return i + offset; }, py::direct_call());
+    m.def("unannotated_adder", [offset](int i) { return i + offset; });
+    std::string prefix(100, '-');
+    m.def(
+        "stateful_prefixer",
+        [prefix](const std::string &s) { return prefix + s; },
+        py::direct_call());
+    m.def("describe_int_function", [](const std::function<int(int)> &f) {
+        using direct_t = py::detail::type_caster_std_function_specializations::
+            direct_func_wrapper<int, int>;
+        py::gil_scoped_release release;
+        auto r = f(1);
+        return std::string(f.target<direct_t>() != nullptr ? "direct" : "wrapped")
+               + ": eval(1) = " + std::to_string(r);
+    });
+    m.def("describe_string_function",
+          [](const std::function<std::string(const std::string &)> &f) {
+              using direct_t = py::detail::type_caster_std_function_specializations::
+                  direct_func_wrapper<std::string, const std::string &>;
+              return std::string(f.target<direct_t>() != nullptr ? "direct" : "wrapped") + ": "
+                     + f("x");
+          });
+    // Captures a Python object, so it must hold the GIL when called from another thread
+    py::object base = py::int_(100);
+    m.def("object_adder", [base](int i) { return base.attr("__add__")(i).cast<int>(); });
+    m.def("call_int_function_in_thread", [](const std::function<int(int)> &f, int i) {
+        using direct_t = py::detail::type_caster_std_function_specializations::
+            direct_func_wrapper<int, int>;
+        int r = 0;
+        {
+            py::gil_scoped_release release;
+            std::thread([&f, &r, i]() { r = f(i); }).join();
+        }
+        return std::string(f.target<direct_t>() != nullptr ? "direct" : "wrapped") + ": "
+               + std::to_string(r);
+    });
+    static std::function<int(int)> stored_function;
+    m.def("store_function", [](std::function<int(int)> f) { stored_function = std::move(f); });
+    m.def("call_stored_function", [](int i) { return stored_function(i); });
+    m.def("clear_stored_function", []() { stored_function = nullptr; });
+
     class AbstractBase {
     public:
         // [workaround(intel)] = default does not work here
@@ -261,6 +308,72 @@ TEST_SUBMODULE(callbacks, m) {
         }
     });
 
+    // test_callback_queue
+    using callback_queue_f = py::callback_queue<void(int)>;
+    auto queue_stats = [](const callback_queue_f &q) {
+        auto st = q.stats();
+        py::dict d;
+        d["enqueued"] = st.enqueued;
+        d["rejected"] = st.rejected;
+        d["executed"] = st.executed;
+        d["batches"] = st.batches;
+        d["max_batch_size"] = st.max_batch_size;
+        d["max_latency_ns"] = st.max_latency.count();
+        return d;
+    };
+    m.def("test_callback_queue_threads",
+          [queue_stats](py::function f, int num_threads, int calls_per_thread, size_t capacity) {
+              callback_queue_f q(std::move(f), capacity);
+              std::vector<std::thread> workers;
+              for (int t = 0; t < num_threads; ++t) {
+                  workers.emplace_back([&q, t, calls_per_thread] {
+                      for (int i = 0; i < calls_per_thread; ++i) {
+                          q.push(t * calls_per_thread + i);
+                      }
+                  });
+              }
+              auto total = static_cast<size_t>(num_threads * calls_per_thread);
+              size_t done = 0;
+              while (done < total) {
+                  done += q.drain();
+                  if (done < total) {
+                      py::gil_scoped_release release;
+                      std::this_thread::yield();
+                  }
+              }
+              {
+                  py::gil_scoped_release release;
+                  for (auto &w : workers) {
+                      w.join();
+                  }
+              }
+              return queue_stats(q);
+          });
+    m.def("test_callback_queue_try_push", [queue_stats](py::function f) {
+        callback_queue_f q(std::move(f), 2);
+        py::list accepted;
+        for (int i = 0; i < 3; ++i) {
+            accepted.append(q.try_push(i));
+        }
+        auto drained = q.drain();
+        return py::make_tuple(accepted, drained, q.size(), queue_stats(q));
+    });
+    m.def("test_callback_queue_error", [queue_stats](py::function f) {
+        callback_queue_f q(std::move(f));
+        for (int i = 0; i < 4; ++i) {
+            q.push(i);
+        }
+        std::string error;
+        try {
+            q.drain();
+        } catch (const py::error_already_set &e) {
+            error = e.what();
+        }
+        auto pending = q.size();
+        auto drained = q.drain();
+        return py::make_tuple(error, pending, drained, queue_stats(q));
+    });
+
     m.def("callback_num_times", [](const py::function &f, std::size_t num) {
         for (std::size_t i = 0; i < num; i++) {
             f();
@@ -89,6 +89,14 @@ def test_keyword_args_and_generalized_unpacking():
         "(#define PYBIND11_DETAILED_ERROR_MESSAGES or compile in debug mode for details)"
     )
 
+    with pytest.raises(RuntimeError) as excinfo:
+        m.test_arg_conversion_error3(f)
+    assert str(excinfo.value) == "Unable to convert call argument " + (
+        "'2' of type 'UnregisteredType' to Python object"
+        if detailed_error_messages_enabled
+        else "'2' to Python object (#define PYBIND11_DETAILED_ERROR_MESSAGES or compile in debug mode for details)"
+    )
+
 
 @pytest.mark.skipif("env.GRAALPY", reason="Cannot reliably trigger GC")
 def test_lambda_closure_cleanup():
@@ -137,6 +145,33 @@ def test_cpp_function_roundtrip():
     )
 
 
+def test_stateful_cpp_function_roundtrip():
+    """Bound C++ functions with captures and an identical signature are called directly"""
+
+    assert m.describe_int_function(m.stateful_adder) == "direct: eval(1) = 11"
+    assert m.describe_string_function(m.stateful_prefixer) == "direct: " + "-" * 100 + "x"
+    assert m.roundtrip(m.stateful_adder) is m.stateful_adder
+    # Direct calls are opt-in (py::direct_call())
+    assert m.describe_int_function(m.unannotated_adder) == "wrapped: eval(1) = 11"
+
+    # Functions with a different signature still go through Python
+    assert m.describe_string_function(lambda s: s + "y") == "wrapped: xy"
+    assert m.describe_int_function(lambda i: i + 2) == "wrapped: eval(1) = 3"
+
+    # The function record stays alive as long as the std::function
+    m.store_function(m.roundtrip(m.stateful_adder))
+    assert m.call_stored_function(5) == 15
+    m.clear_stored_function()
+
+
+@pytest.mark.skipif(sys.platform.startswith("emscripten"), reason="Requires threads")
+def test_capturing_python_object_called_from_thread():
+    """Functions capturing Python objects acquire the GIL when called from C++ threads"""
+
+    assert m.call_int_function_in_thread(m.object_adder, 1) == "wrapped: 101"
+    assert m.call_int_function_in_thread(m.stateful_adder, 1) == "direct: 11"
+
+
 def test_function_signatures(doc):
     assert (
         doc(m.test_callback3)
@@ -194,6 +229,49 @@ def test_async_async_callbacks():
     t.join()
 
 
+@pytest.mark.skipif(sys.platform.startswith("emscripten"), reason="Requires threads")
+def test_callback_queue_threads():
+    res = []
+    stats = m.test_callback_queue_threads(res.append, 4, 250, 16)
+    assert sorted(res) == list(range(1000))
+    assert stats["enqueued"] == stats["executed"] == 1000
+    assert stats["rejected"] == 0
+    assert 1 <= stats["max_batch_size"] <= 16
+    assert stats["batches"] * stats["max_batch_size"] >= 1000
+    assert stats["max_latency_ns"] >= 0
+
+
+def test_callback_queue_try_push():
+    res = []
+    accepted, drained, pending, stats = m.test_callback_queue_try_push(res.append)
+    assert accepted == [True, True, False]
+    assert drained == 2
+    assert pending == 0
+    assert res == [0, 1]
+    assert stats["enqueued"] == 2
+    assert stats["rejected"] == 1
+    assert stats["batches"] == 1
+    assert stats["max_batch_size"] == 2
+
+
+def test_callback_queue_error():
+    res = []
+
+    def f(i):
+        if i == 1:
+            raise ValueError("callback failed")
+        res.append(i)
+
+    error, pending, drained, stats = m.test_callback_queue_error(f)
+    assert "callback failed" in error
+    # The calls after the failed one stay queued and run with the next drain()
+    assert pending == 2
+    assert drained == 2
+    assert res == [0, 2, 3]
+    assert stats["executed"] == 4
+    assert stats["batches"] == 2
+
+
 def test_callback_num_times():
     # Super-simple micro-benchmarking related to PR #2919.
     # Example runtimes (Intel Xeon 2.2GHz, fully optimized):
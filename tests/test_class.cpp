@@ -65,6 +65,23 @@ struct ConvertibleFromAnything {
     ConvertibleFromAnything(T &&) {}
 };
 
+// py::inline_value(): counts live objects to check that inline values are destroyed
+struct InlineValue {
+    explicit InlineValue(int value) : value(value) { ++alive; }
+    InlineValue(const InlineValue &other) : value(other.value), text(other.text) { ++alive; }
+    InlineValue &operator=(const InlineValue &) = default;
+    ~InlineValue() { --alive; }
+    int value;
+    std::string text = "inline";
+    static int alive;
+};
+int InlineValue::alive = 0;
+
+struct InlineDerived : InlineValue {
+    explicit InlineDerived(int value) : InlineValue(value), extra(value * 10) {}
+    int extra;
+};
+
 } // namespace test_class
 
 static_assert(py::detail::is_same_or_base_of<py::args, py::args>::value, "");
@@ -590,6 +607,103 @@ TEST_SUBMODULE(class_, m) {
         py::class_<OtherDuplicateNested>(gt, "YetAnotherDuplicateNested");
     });
 
+    // Type lookups are cached; looking a type up before registering it must not hide it later
+    struct RegisteredLate {};
+    m.def("register_late_class", [](const py::module_ &m) {
+        bool before = py::detail::get_type_info(typeid(RegisteredLate)) != nullptr;
+        py::class_<RegisteredLate>(m, "RegisteredLate").def(py::init<>());
+        bool after = py::detail::get_type_info(typeid(RegisteredLate)) != nullptr;
+        return py::make_tuple(before, after);
+    });
+
+    // py::no_instance_tracking(): instances are not registered, so casting the same C++ object
+    // twice yields two distinct Python objects
+    struct UntrackedValue {
+        int value = 0;
+    };
+    m.attr("instance_tracking_optional") = PYBIND11_INTERNALS_VERSION >= 13;
+    py::class_<UntrackedValue>(m, "UntrackedValue", py::no_instance_tracking())
+        .def(py::init<>())
+        .def_readwrite("value", &UntrackedValue::value);
+    static UntrackedValue untracked_value;
+    m.def(
+        "get_untracked_value",
+        []() -> UntrackedValue & { return untracked_value; },
+        py::return_value_policy::reference);
+    // Taking ownership of a raw pointer is refused, as it may be owned by another instance
+    m.def("get_untracked_value_ptr", []() { return &untracked_value; });
+    m.def("make_untracked_value", [](int value) {
+        std::unique_ptr<UntrackedValue> result(new UntrackedValue());
+        result->value = value;
+        return result;
+    });
+
+    // py::inline_value(): the C++ object is stored inside the Python object
+    using test_class::InlineDerived;
+    using test_class::InlineValue;
+#if PYBIND11_INTERNALS_VERSION >= 13 && !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+    m.attr("inline_values_supported") = true;
+#else
+    m.attr("inline_values_supported") = false;
+#endif
+    py::class_<InlineValue, std::unique_ptr<InlineValue>>(m, "InlineValue", py::inline_value())
+        .def(py::init<int>())
+        .def(py::init([](const std::string &text) {
+            InlineValue v(0);
+            v.text = text;
+            return v;
+        }))
+        .def_readwrite("value", &InlineValue::value)
+        .def_readwrite("text", &InlineValue::text)
+        .def_static("alive", []() { return InlineValue::alive; });
+    py::class_<InlineDerived, InlineValue, std::unique_ptr<InlineDerived>>(
+        m, "InlineDerived", py::inline_value())
+        .def(py::init<int>())
+        .def_readonly("extra", &InlineDerived::extra);
+    m.def("make_inline_value", [](int value) { return InlineValue(value); });
+    m.def("make_unique_inline_value",
+          [](int value) { return std::unique_ptr<InlineValue>(new InlineValue(value)); });
+    m.def("value_is_inline", [](const py::handle &obj) {
+        auto *inst = reinterpret_cast<py::detail::instance *>(obj.ptr());
+        auto *tinfo = py::detail::get_type_info(Py_TYPE(obj.ptr()));
+        return py::detail::value_is_inline(inst->get_value_and_holder(tinfo));
+    });
+
+    // py::freelist(): storage of destroyed instances is reused by new ones
+    struct RecycledValue {
+        explicit RecycledValue(int value) : value(value) {}
+        int value;
+    };
+    struct RecycledSmartHolderValue {
+        explicit RecycledSmartHolderValue(int value) : value(value) {}
+        int value;
+    };
+    py::class_<RecycledValue>(m, "RecycledValue", py::freelist(4))
+        .def(py::init<int>())
+        .def_readonly("value", &RecycledValue::value);
+    // The smart_holder is too large for the simple instance layout
+    py::class_<RecycledSmartHolderValue, py::smart_holder>(
+        m, "RecycledSmartHolderValue", py::freelist(4))
+        .def(py::init<int>())
+        .def_readonly("value", &RecycledSmartHolderValue::value);
+    m.def("make_recycled_value", [](int value) { return RecycledValue(value); });
+#ifdef PYBIND11_HAS_INSTANCE_FREELIST
+    m.attr("has_instance_freelist") = true;
+    m.def("freelist_stats", []() {
+        const auto &stats = py::detail::get_internals().freelist_stats;
+        return py::dict(py::arg("reused") = stats.reused,
+                        py::arg("allocated") = stats.allocated,
+                        py::arg("recycled") = stats.recycled,
+                        py::arg("released") = stats.released);
+    });
+    m.def("freelist_size", [](const py::type &type) {
+        auto *tinfo = py::detail::get_type_info((PyTypeObject *) type.ptr());
+        return tinfo->freelist ? tinfo->freelist->objects.size() : 0;
+    });
+#else
+    m.attr("has_instance_freelist") = false;
+#endif
+
     test_class::pr4220_tripped_over_this::bind_empty0(m);
 
     // Regression test for compiler error that showed up in #5866
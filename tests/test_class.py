@@ -540,6 +540,119 @@ def test_register_duplicate_class():
     assert str(exc_info.value) == expected
 
 
+def test_register_late_class():
+    import types
+
+    module_scope = types.ModuleType("module_scope")
+    assert m.register_late_class(module_scope) == (False, True)
+    assert isinstance(module_scope.RegisteredLate(), module_scope.RegisteredLate)
+
+
+@pytest.mark.skipif(
+    not m.instance_tracking_optional, reason="Requires PYBIND11_INTERNALS_VERSION >= 13"
+)
+def test_no_instance_tracking():
+    registered = ConstructorStats.detail_reg_inst()
+    values = [m.UntrackedValue() for _ in range(10)]
+    assert ConstructorStats.detail_reg_inst() == registered
+
+    a = m.get_untracked_value()
+    b = m.get_untracked_value()
+    assert a is not b
+    assert ConstructorStats.detail_reg_inst() == registered
+    a.value = 42
+    assert b.value == 42
+
+    # Two owning instances of the same pointer would delete it twice
+    with pytest.raises(RuntimeError, match="py::no_instance_tracking"):
+        m.get_untracked_value_ptr()
+    c = m.make_untracked_value(7)
+    assert c.value == 7
+
+    del values, a, b, c
+    assert ConstructorStats.detail_reg_inst() == registered
+
+
+@pytest.mark.skipif(
+    not m.inline_values_supported, reason="Inline values are not supported on this build"
+)
+def test_inline_value():
+    alive = m.InlineValue.alive()
+
+    class Derived(m.InlineValue):
+        pass
+
+    values = [
+        m.InlineValue(1),
+        m.InlineValue("text"),
+        m.make_inline_value(3),
+        Derived(4),
+        m.InlineDerived(5),
+    ]
+    assert all(m.value_is_inline(v) for v in values)
+    assert [v.value for v in values] == [1, 0, 3, 4, 5]
+    assert [v.text for v in values] == ["inline", "text", "inline", "inline", "inline"]
+    assert values[4].extra == 50
+    assert m.InlineValue.alive() == alive + 5
+
+    # Values created outside of pybind11 are still held by std::unique_ptr
+    unique = m.make_unique_inline_value(6)
+    assert not m.value_is_inline(unique)
+    assert unique.value == 6
+    assert m.InlineValue.alive() == alive + 6
+
+    del values, unique
+    assert m.InlineValue.alive() == alive
+
+
+@pytest.mark.skipif(
+    not m.has_instance_freelist, reason="Instance freelists are not used on this build"
+)
+@pytest.mark.parametrize("cls", [m.RecycledValue, m.RecycledSmartHolderValue])
+def test_freelist(cls):
+    def stats_delta(before):
+        return {k: v - before[k] for k, v in m.freelist_stats().items()}
+
+    values = [cls(i) for i in range(6)]
+    del values
+    assert m.freelist_size(cls) == 4
+
+    before = m.freelist_stats()
+    values = [cls(i) for i in range(6)]
+    assert [v.value for v in values] == list(range(6))
+    assert len({id(v) for v in values}) == 6
+    assert m.freelist_size(cls) == 0
+    del values
+    assert m.freelist_size(cls) == 4
+    assert stats_delta(before) == {
+        "reused": 4,
+        "allocated": 2,
+        "recycled": 4,
+        "released": 2,
+    }
+
+    # Instances of Python subclasses do not use the freelist
+    class Derived(cls):
+        pass
+
+    before = m.freelist_stats()
+    derived = [Derived(i) for i in range(6)]
+    assert [v.value for v in derived] == list(range(6))
+    del derived
+    assert stats_delta(before) == dict.fromkeys(before, 0)
+
+
+@pytest.mark.skipif(
+    not m.has_instance_freelist, reason="Instance freelists are not used on this build"
+)
+def test_freelist_return_by_value():
+    m.RecycledValue(1)
+    assert m.freelist_size(m.RecycledValue) > 0
+    before = m.freelist_stats()
+    assert m.make_recycled_value(42).value == 42
+    assert m.freelist_stats()["reused"] == before["reused"] + 1
+
+
 def test_pr4220_tripped_over_this():
     assert (
         m.Empty0().get_msg()
@@ -11,8 +11,10 @@
 
 #include "pybind11_tests.h"
 
+#include <atomic>
 #include <string>
 #include <thread>
+#include <vector>
 
 #define CROSS_MODULE(Function)                                                                    \
     auto cm = py::module_::import("cross_module_gil_utils");                                      \
@@ -141,4 +143,37 @@ TEST_SUBMODULE(gil_scoped, m) {
         }
         return internals_ids;
     });
+
+#if PYBIND11_INTERNALS_VERSION >= 13 && !defined(PYBIND11_SIMPLE_GIL_MANAGEMENT)
+    // Returns how many thread states were created, reused and deleted by threads unknown to
+    // Python that acquire the GIL repeatedly
+    m.def("count_thread_states", [](size_t keep, int num_threads, int acquisitions) {
+        py::keep_thread_states(keep);
+        auto &cache = *py::detail::get_internals().thread_states;
+        size_t created = cache.created, reused = cache.reused, deleted = cache.deleted;
+        {
+            py::gil_scoped_release gil_released;
+            std::vector<std::thread> threads;
+            std::atomic<int> started{0};
+            for (int i = 0; i < num_threads; ++i) {
+                threads.emplace_back([acquisitions, num_threads, &started]() {
+                    for (int j = 0; j < acquisitions; ++j) {
+                        py::gil_scoped_acquire gil_acquired;
+                    }
+                    // Keep all threads alive until each has acquired the GIL at least once
+                    ++started;
+                    while (started < num_threads) {
+                        std::this_thread::yield();
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+        py::keep_thread_states(0);
+        return py::make_tuple(
+            cache.created - created, cache.reused - reused, cache.deleted - deleted);
+    });
+#endif
 }
@@ -292,3 +292,16 @@ def test_run_in_process_direct(test_fn):
     This test is for completion, but it was never an issue.
     """
     assert _run_in_process(test_fn) == 0
+
+
+@pytest.mark.skipif(sys.platform.startswith("emscripten"), reason="Requires threads")
+@pytest.mark.skipif(
+    not hasattr(m, "count_thread_states"), reason="Requires PYBIND11_INTERNALS_VERSION >= 13"
+)
+def test_keep_thread_states():
+    # By default, each acquisition creates and deletes a thread state
+    assert m.count_thread_states(0, 2, 5) == (10, 0, 10)
+    # Kept thread states are reused and deleted when the threads exit
+    assert m.count_thread_states(4, 2, 5) == (2, 8, 2)
+    # Only up to the limit
+    assert m.count_thread_states(1, 2, 5) == (6, 4, 6)
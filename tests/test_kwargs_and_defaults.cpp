@@ -328,4 +328,44 @@ TEST_SUBMODULE(kwargs_and_defaults, m) {
           [](const py::Args<std::string> &args, const py::KWArgs<std::string> &kwargs) {
               return py::make_tuple(args, kwargs);
           });
+
+    // test_call_plan: calls without keyword arguments are filled from the precomputed call plan
+    m.def(
+        "call_plan_defaults",
+        [](int a, int b, int c) { return py::make_tuple(a, b, c); },
+        py::arg("a"),
+        py::arg("b") = 2,
+        py::arg("c") = 3);
+    m.def(
+        "call_plan_no_none_default",
+        [](const py::object &o) { return o; },
+        py::arg("o").none(false) = py::none());
+    struct CallPlanInit {
+        int a, b;
+    };
+    py::class_<CallPlanInit>(m, "CallPlanInit")
+        .def(py::init([](int a, int b) { return CallPlanInit{a, b}; }),
+             py::arg("a"),
+             py::arg("b") = 5)
+        .def_readonly("a", &CallPlanInit::a)
+        .def_readonly("b", &CallPlanInit::b);
+
+    // test_keyword_names: keyword arguments are matched against the interned argument names
+    m.def(
+        "many_kwargs",
+        [](int a, int b, int c, int d, int e, int f, int g, int h) {
+            return py::make_tuple(a, b, c, d, e, f, g, h);
+        },
+        py::arg("x0") = 1,
+        py::arg("x1") = 2,
+        py::arg("x2") = 3,
+        py::arg("x3") = 4,
+        py::arg("x4") = 5,
+        py::arg("x5") = 6,
+        py::arg("x6") = 7,
+        py::arg("x7") = 8);
+    m.def(
+        "kwargs_leftover",
+        [](int x0, const py::kwargs &kwargs) { return py::make_tuple(x0, kwargs); },
+        py::arg("x0") = 0);
 }
@@ -415,6 +415,48 @@ def test_signatures():
     )
 
 
+def test_call_plan():
+    assert m.call_plan_defaults(1) == (1, 2, 3)
+    assert m.call_plan_defaults(1, 5) == (1, 5, 3)
+    assert m.call_plan_defaults(1, 5, 7) == (1, 5, 7)
+    assert m.call_plan_defaults(1, c=9) == (1, 2, 9)
+    with pytest.raises(TypeError):
+        m.call_plan_defaults()
+    with pytest.raises(TypeError):
+        m.call_plan_defaults(1, 2, 3, 4)
+    with pytest.raises(TypeError):
+        m.call_plan_defaults(None)
+
+    assert m.call_plan_no_none_default(1) == 1
+    with pytest.raises(TypeError):
+        m.call_plan_no_none_default()
+
+    obj = m.CallPlanInit(1)
+    assert (obj.a, obj.b) == (1, 5)
+    obj = m.CallPlanInit(3, 4)
+    assert (obj.a, obj.b) == (3, 4)
+    with pytest.raises(TypeError):
+        m.CallPlanInit()
+
+
+def test_keyword_names():
+    assert m.many_kwargs(x7=80, x0=10, x3=40) == (10, 2, 3, 40, 5, 6, 7, 80)
+    assert m.many_kwargs(10, 20, x6=70) == (10, 20, 3, 4, 5, 6, 70, 8)
+
+    # Keyword names built at runtime are not interned: they are matched by value instead
+    kwargs = {"x" + str(i): 10 * (i + 1) for i in range(8)}
+    assert m.many_kwargs(**kwargs) == (10, 20, 30, 40, 50, 60, 70, 80)
+    assert m.many_kwargs(**{"x" + str(2): 0}) == (1, 2, 0, 4, 5, 6, 7, 8)
+
+    with pytest.raises(TypeError):
+        m.many_kwargs(1, **{"x" + str(0): 2})
+    with pytest.raises(TypeError):
+        m.many_kwargs(**{"x" + str(8): 9})
+
+    assert m.kwargs_leftover(x0=1, y=2) == (1, {"y": 2})
+    assert m.kwargs_leftover(**{"x" + str(0): 1, "x" + str(1): 2}) == (1, {"x1": 2})
+
+
 @pytest.mark.skipif("env.GRAALPY", reason="Different refcounting mechanism")
 def test_args_refcount():
     """Issue/PR #1216 - py::args elements get double-inc_ref()ed when combined with regular
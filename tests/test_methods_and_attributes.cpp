@@ -499,6 +499,16 @@ TEST_SUBMODULE(methods_and_attributes, m) {
     m.def("overload_order", [](int) { return 3; });
     m.def("overload_order", [](int) { return 4; }, py::prepend{});
 
+    // test_overload_cache
+    m.def("overload_cache", [](std::uint8_t) { return "uint8"; }, py::overload_cache());
+    m.def("overload_cache", [](std::int64_t) { return "int64"; });
+    m.def("overload_cache", [](double) { return "double"; });
+    m.def("overload_cache", [](const std::string &) { return "str"; });
+
+    // test_overload_cache_conversion_pass
+    m.def("overload_cache_convert", [](int) { return "int"; }, py::overload_cache());
+    m.def("overload_cache_convert", [](double) { return "double"; }, py::overload_cache());
+
 #if !defined(PYPY_VERSION)
     // test_dynamic_attributes
     class DynamicClass {
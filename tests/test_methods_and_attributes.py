@@ -698,6 +698,36 @@ def test_overload_ordering():
     )
 
 
+def test_overload_cache():
+    class Floaty:
+        def __float__(self):
+            return 2.5
+
+    for _ in range(3):
+        assert m.overload_cache(3) == "uint8"
+        assert m.overload_cache("x") == "str"
+        assert m.overload_cache(1.5) == "double"
+        assert m.overload_cache(Floaty()) == "double"  # conversion pass
+    # The cached uint8 overload fails for this value; falls back to full overload resolution
+    assert m.overload_cache(300) == "int64"
+    assert m.overload_cache(-300) == "int64"
+
+    with pytest.raises(TypeError):
+        m.overload_cache(None)
+    with pytest.raises(TypeError):
+        m.overload_cache(1, 2)
+
+
+def test_overload_cache_conversion_pass():
+    assert m.overload_cache_convert(5) == "int"
+    # Too large for `int`: falls back to the `double` overload
+    assert m.overload_cache_convert(2**70) == "double"
+    # The `double` overload must not replace the cached `int` overload
+    assert m.overload_cache_convert(5) == "int"
+    assert m.overload_cache_convert(2.5) == "double"
+    assert m.overload_cache_convert(5) == "int"
+
+
 def test_rvalue_ref_param():
     r = m.RValueRefParam()
     assert r.func1("123") == 3
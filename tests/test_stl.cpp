@@ -18,7 +18,12 @@
 
 #include <pybind11/typing.h>
 
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <numeric>
 #include <string>
+#include <valarray>
 #include <vector>
 
 #if defined(PYBIND11_TEST_BOOST)
@@ -226,6 +231,48 @@ TEST_SUBMODULE(stl, m) {
         return v.size() == 3 && v[0] == 1 && v[1] == 4 && v[2] == 9;
     });
 
+    // test_load_from_buffer
+    m.def("sum_vector_double", [](const std::vector<double> &v) {
+        return std::accumulate(v.begin(), v.end(), 0.0);
+    });
+    m.def("load_deque_int64", [](const std::deque<std::int64_t> &v) { return v; });
+    m.def("load_array_int", [](const std::array<int, 3> &a) { return a; });
+    m.def("load_valarray_float", [](const std::valarray<float> &v) { return v.sum(); });
+    m.def("load_vector_char",
+          [](const std::vector<char> &v) { return std::string(v.begin(), v.end()); });
+
+    // test_load_list_and_tuple_items
+    // (std::vector<unsigned char> is bound as an opaque type in test_stl_binders.cpp)
+    m.def("load_vector_uint16", [](const std::vector<std::uint16_t> &v) { return v; });
+
+    // test_lazy_sequence
+    m.def(
+        "lazy_vector_double",
+        [](std::size_t n) {
+            std::vector<double> v(n);
+            std::iota(v.begin(), v.end(), 0.0);
+            return v;
+        },
+        py::return_value_policy::lazy_sequence);
+    m.def(
+        "lazy_vector_pair",
+        []() {
+            return std::vector<std::pair<std::string, int>>{{"a", 1}, {"b", 2}, {"c", 3}};
+        },
+        py::return_value_policy::lazy_sequence);
+    m.def(
+        "lazy_vector_reference",
+        []() -> const std::vector<int> & {
+            static const std::vector<int> v{1, 2, 3};
+            return v;
+        },
+        py::return_value_policy::lazy_sequence);
+    m.def(
+        "lazy_deque", []() { return std::deque<int>{1, 2}; }, py::return_value_policy::lazy_sequence);
+    m.def("cast_lazy_sequence", []() {
+        return py::cast(std::vector<int>{4, 5}, py::return_value_policy::lazy_sequence);
+    });
+
     // test_map
     m.def("cast_map", []() { return std::map<std::string, std::string>{{"key", "value"}}; });
     m.def("load_map", [](const std::map<std::string, std::string> &map) {
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import array
 import weakref
 
 import pytest
@@ -204,6 +205,101 @@ def test_valarray(doc):
     )
 
 
+def test_load_from_buffer():
+    """Buffers of matching numbers are copied in bulk, without iterating"""
+
+    class CountingArray(array.array):
+        iter_calls = 0
+
+        def __iter__(self):
+            CountingArray.iter_calls += 1
+            return super().__iter__()
+
+    values = CountingArray("d", [0.5, 1.5, 2.0])
+    assert m.sum_vector_double(values) == 4.0
+    assert m.sum_vector_double(memoryview(values)) == 4.0
+    assert CountingArray.iter_calls == 0
+    assert m.sum_vector_double(CountingArray("d")) == 0.0
+
+    # Other formats and strided buffers are converted item by item
+    assert m.sum_vector_double(CountingArray("f", [0.5, 1.5])) == 2.0
+    assert CountingArray.iter_calls == 1
+    assert m.sum_vector_double(memoryview(array.array("d", [1, 2, 3, 4]))[::2]) == 4.0
+
+    assert m.load_deque_int64(array.array("q", [1, -2, 3])) == [1, -2, 3]
+    assert m.load_array_int(array.array("i", [4, 5, 6])) == [4, 5, 6]
+    with pytest.raises(TypeError):
+        m.load_array_int(array.array("i", [4, 5]))
+    assert m.load_valarray_float(array.array("f", [0.25, 0.75])) == 1.0
+
+    # Characters are loaded from strings, never from buffers of small integers
+    assert m.load_vector_char(["a", "b"]) == "ab"
+    for fmt in ("b", "B"):
+        with pytest.raises(TypeError):
+            m.load_vector_char(array.array(fmt, [97, 98]))
+
+
+def test_load_list_and_tuple_items():
+    """Items of exact lists and tuples are read directly, with the same conversion rules"""
+    assert m.load_deque_int64([1, -(2**63), 2**63 - 1]) == [1, -(2**63), 2**63 - 1]
+    assert m.load_deque_int64((4, 5)) == [4, 5]
+    assert m.load_vector_uint16([0, 65535]) == [0, 65535]
+    for out_of_range in ([65536], [-1], [2**64]):
+        with pytest.raises(TypeError):
+            m.load_vector_uint16(out_of_range)
+    with pytest.raises(TypeError):
+        m.load_deque_int64([1.5])
+    assert m.sum_vector_double([0.5, 1, True]) == 2.5
+    assert m.load_array_int((1, 2, 3)) == [1, 2, 3]
+    with pytest.raises(TypeError):
+        m.load_array_int([1, 2])
+    assert m.load_valarray_float([0.5, 2]) == 2.5
+
+    # Converting an element may run Python code that shrinks the list
+    items = []
+
+    class Shrinking:
+        def __index__(self):
+            items.clear()
+            return 7
+
+    items.extend([Shrinking(), 2, 3])
+    assert m.load_deque_int64(items) == [7]
+    items.extend([Shrinking(), 2, 3])
+    with pytest.raises(TypeError):
+        m.load_array_int(items)
+
+
+def test_lazy_sequence():
+    seq = m.lazy_vector_double(5)
+    assert not isinstance(seq, list)
+    assert len(seq) == 5
+    assert seq[1] == 1.0
+    assert seq[-1] == 4.0
+    with pytest.raises(IndexError):
+        seq[5]
+    assert list(seq) == [0.0, 1.0, 2.0, 3.0, 4.0]
+    part = seq[1:5:2]
+    assert type(part) is type(seq)
+    assert list(part) == [1.0, 3.0]
+
+    view = memoryview(seq)
+    assert view.readonly
+    assert view.format == "d"
+    assert view.tolist() == [0.0, 1.0, 2.0, 3.0, 4.0]
+
+    pairs = m.lazy_vector_pair()
+    assert pairs[0] == ("a", 1)
+    assert list(pairs[::-1]) == [("c", 3), ("b", 2), ("a", 1)]
+    with pytest.raises(TypeError):
+        memoryview(pairs)
+
+    assert list(m.lazy_vector_reference()) == [1, 2, 3]
+    assert list(m.cast_lazy_sequence()) == [4, 5]
+    # Only std::vector supports the policy; other containers are still lists
+    assert m.lazy_deque() == [1, 2]
+
+
 def test_map(doc):
     """std::map <-> dict"""
     d = m.cast_map()
@@ -12,6 +12,7 @@
 
 #include "pybind11_tests.h"
 
+#include <cstdint>
 #include <deque>
 #include <map>
 #include <unordered_map>
@@ -192,6 +193,10 @@ TEST_SUBMODULE(stl_binders, m) {
     py::bind_map<std::unordered_map<std::string, double const>>(m,
                                                                 "UnorderedMapStringDoubleConst");
 
+    // test_map_arrays
+    py::bind_map<std::map<int32_t, double>>(m, "MapInt32Double");
+    py::bind_map<std::unordered_map<int64_t, float>>(m, "UnorderedMapInt64Float");
+
     // test_map_view_types
     py::bind_map<std::map<std::string, float>>(m, "MapStringFloat");
     py::bind_map<std::unordered_map<std::string, float>>(m, "UnorderedMapStringFloat");
@@ -231,6 +236,13 @@ TEST_SUBMODULE(stl_binders, m) {
 
     // test_vector_buffer
     py::bind_vector<std::vector<unsigned char>>(m, "VectorUChar", py::buffer_protocol());
+    // test_vector_from_buffer
+    // Not converted by any other test: binding a vector type that is also converted with
+    // pybind11/stl.h elsewhere in the module would violate the ODR.
+    py::bind_vector<std::vector<std::int16_t>>(m, "VectorInt16");
+    // Like the list caster, bound vectors of characters don't copy buffers of small integers
+    static_assert(!py::detail::is_bulk_copyable<char>::value, "");
+    static_assert(py::detail::is_bulk_copyable<std::int16_t>::value, "");
     // no dtype declared for this version:
     struct VUndeclStruct {
         bool w;
@@ -272,4 +284,7 @@ TEST_SUBMODULE(stl_binders, m) {
     py::bind_vector<std::vector<VStruct>>(m, "VectorStruct", py::buffer_protocol());
     m.def("get_vectorstruct",
           [] { return std::vector<VStruct>{{false, 5, 3.0, true}, {true, 30, -1e4, false}}; });
+
+    // test_map_arrays_numpy
+    py::bind_map<std::map<int, VStruct>>(m, "MapIntStruct");
 }
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import array
 import sys
 
 import pytest
@@ -123,6 +124,33 @@ def test_vector_buffer():
     assert "NumPy type info missing for " in str(excinfo.value)
 
 
+def test_vector_from_buffer():
+    v = m.VectorInt16(array.array("h", [1, 2, 3]))
+    assert list(v) == [1, 2, 3]
+    v.extend(memoryview(array.array("h", [4, 5, 6, 7]))[::2])
+    assert list(v) == [1, 2, 3, 4, 6]
+    v.extend(memoryview(array.array("h", [8, 9]))[::-1])
+    assert list(v) == [1, 2, 3, 4, 6, 9, 8]
+    # Buffers of other formats are still converted item by item
+    v.extend(array.array("q", [-5]))
+    assert list(v) == [1, 2, 3, 4, 6, 9, 8, -5]
+
+    v[0:2] = array.array("h", [8, 9])
+    v[::2] = array.array("q", [0, 0, 0, 0])
+    assert list(v) == [0, 9, 0, 4, 0, 9, 0, -5]
+    with pytest.raises(RuntimeError):
+        v[0:2] = array.array("h", [1])
+
+    b = m.VectorUChar(b"abcd")
+    b[1:3] = b"xy"
+    assert bytes(b) == b"axyd"
+
+    # The buffer may be a view of the vector itself
+    vi = m.VectorInt([1, 2, 3])
+    vi.extend(memoryview(vi))
+    assert list(vi) == [1, 2, 3, 1, 2, 3]
+
+
 def test_vector_buffer_numpy():
     np = pytest.importorskip("numpy")
     a = np.array([1, 2, 3, 4], dtype=np.int32)
@@ -368,6 +396,56 @@ def test_map_delitem():
     assert sorted(um.items()) == [("ub", 2.6)]
 
 
+def test_map_arrays():
+    mp = m.MapInt32Double()
+    mp.update_from_arrays(array.array("i", [3, 1, 2]), array.array("d", [0.3, 0.1, 0.2]))
+    assert dict(mp.items()) == {1: 0.1, 2: 0.2, 3: 0.3}
+
+    keys = mp.keys_array()
+    assert len(keys) == 3
+    view = memoryview(keys)
+    assert view.readonly
+    assert view.format == "i"
+    assert view.tolist() == [1, 2, 3]
+    assert memoryview(mp.values_array()).tolist() == [0.1, 0.2, 0.3]
+    assert memoryview(m.MapInt32Double().keys_array()).tolist() == []
+
+    # Existing keys are assigned, and strided buffers are accepted
+    mp.update_from_arrays(
+        memoryview(array.array("i", [1, 0, 4]))[::2], array.array("d", [1.0, 4.0])
+    )
+    assert dict(mp.items()) == {1: 1.0, 2: 0.2, 3: 0.3, 4: 4.0}
+
+    with pytest.raises(TypeError, match="Format mismatch"):
+        mp.update_from_arrays(array.array("q", [1]), array.array("d", [1.0]))
+    with pytest.raises(ValueError):
+        mp.update_from_arrays(array.array("i", [1, 2]), array.array("d", [1.0]))
+
+    ump = m.UnorderedMapInt64Float()
+    ump.update_from_arrays(array.array("q", [5, 6]), array.array("f", [0.5, 1.5]))
+    assert ump[6] == 1.5
+    assert sorted(memoryview(ump.keys_array()).tolist()) == [5, 6]
+
+    # Only provided if both the keys and the values have a buffer format
+    assert not hasattr(m.MapStringDouble(), "keys_array")
+
+
+def test_map_arrays_numpy():
+    np = pytest.importorskip("numpy")
+    mp = m.MapIntStruct()
+    values = np.zeros(
+        2,
+        dtype=np.dtype(
+            [("w", "bool"), ("x", "I"), ("y", "float64"), ("z", "bool")], align=True
+        ),
+    )
+    values["x"] = [10, 20]
+    mp.update_from_arrays(np.array([2, 1], dtype=np.intc), values)
+    assert mp[1].x == 20
+    assert list(np.asarray(mp.keys_array())) == [1, 2]
+    assert list(np.asarray(mp.values_array())["x"]) == [20, 10]
+
+
 def test_map_view_types():
     map_string_double = m.MapStringDouble()
     unordered_map_string_double = m.UnorderedMapStringDouble()
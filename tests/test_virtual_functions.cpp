@@ -166,6 +166,18 @@ struct DispatchIssue : Base {
     }
 };
 
+// Detects recursion into Python overrides with a thread-local marker instead of frame inspection
+struct GuardedCounter {
+    GuardedCounter() = default;
+    GuardedCounter(const GuardedCounter &) = delete;
+    virtual ~GuardedCounter() = default;
+    virtual int step(int n) { return n + 1; }
+};
+
+struct PyGuardedCounter : GuardedCounter {
+    int step(int n) override { PYBIND11_OVERRIDE(int, GuardedCounter, step, n); }
+};
+
 // An abstract adder class that uses visitor pattern to add two data
 // objects and send the result to the visitor functor
 struct AdderBase {
@@ -321,6 +333,14 @@ TEST_SUBMODULE(virtual_functions, m) {
 
     m.def("dispatch_issue_go", [](const Base *b) { return b->dispatch(); });
 
+    // test_thread_local_override_guard
+    py::class_<GuardedCounter, PyGuardedCounter>(
+        m, "GuardedCounter", py::thread_local_override_guard())
+        .def(py::init<>())
+        .def("step", &GuardedCounter::step);
+    m.def("guarded_step", [](GuardedCounter &counter, int n) { return counter.step(n); });
+    m.attr("has_thread_local_override_guard") = PYBIND11_INTERNALS_VERSION >= 13;
+
     // test_recursive_dispatch_issue
     // #3357: Recursive dispatch fails to find python function override
     pybind11::class_<AdderBase, Adder>(m, "Adder")
@@ -410,6 +430,13 @@ TEST_SUBMODULE(virtual_functions, m) {
         .def("func", &test_override_cache_helper::func);
 
     m.def("test_override_cache", test_override_cache);
+
+    // test_override_cache_invalidation
+#if PYBIND11_INTERNALS_VERSION >= 13 && defined(PYBIND11_HAS_OVERRIDE_TABLES)
+    m.attr("has_override_tables") = true;
+#else
+    m.attr("has_override_tables") = false;
+#endif
 }
 
 // Inheriting virtual methods.  We do two versions here: the repeat-everything version and the
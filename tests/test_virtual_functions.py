@@ -264,6 +264,42 @@ def test_dispatch_issue(msg):
     assert m.dispatch_issue_go(b) == "Yay.."
 
 
+@pytest.mark.skipif(
+    not m.has_thread_local_override_guard, reason="Requires PYBIND11_INTERNALS_VERSION >= 13"
+)
+def test_thread_local_override_guard():
+    class Scaled(m.GuardedCounter):
+        def step(self, n):
+            return 10 * super().step(n)
+
+    class Indirect(m.GuardedCounter):
+        def step(self, n):
+            # Not detected by frame inspection, which only looks at the calling frame
+            return (lambda: m.GuardedCounter.step(self, n))() + 100  # noqa: PLC3002
+
+    class Forwarding(m.GuardedCounter):
+        def __init__(self, target):
+            super().__init__()
+            self.target = target
+
+        def step(self, n):
+            # Overrides of other objects are still dispatched to Python
+            return m.guarded_step(self.target, n) + m.guarded_step(self, n)
+
+    class Failing(m.GuardedCounter):
+        def step(self, n):
+            raise ValueError(n)
+
+    assert m.guarded_step(m.GuardedCounter(), 1) == 2
+    assert m.guarded_step(Scaled(), 1) == 20
+    assert m.guarded_step(Indirect(), 1) == 102
+    assert m.guarded_step(Forwarding(Scaled()), 1) == 22
+    failing = Failing()
+    for _ in range(2):
+        with pytest.raises(ValueError):
+            m.guarded_step(failing, 1)
+
+
 def test_recursive_dispatch_issue():
     """#3357: Recursive dispatch fails to find python function override"""
 
@@ -466,3 +502,33 @@ def test_python_override():
     for _ in range(1500):
         assert m.test_override_cache(func()) == 42
         assert m.test_override_cache(func2()) == 0
+
+
+@pytest.mark.skipif(
+    not m.has_override_tables, reason="Overrides are only looked up once per type"
+)
+def test_override_cache_invalidation():
+    class Test(m.test_override_cache_helper):
+        pass
+
+    class Derived(Test):
+        pass
+
+    obj, derived = Test(), Derived()
+    for _ in range(3):
+        assert m.test_override_cache(obj) == 0
+        assert m.test_override_cache(derived) == 0
+
+    # Adding, replacing, or removing an override after the first lookup (also in a base class)
+    Test.func = lambda self: 1
+    assert m.test_override_cache(obj) == 1
+    assert m.test_override_cache(derived) == 1
+    Derived.func = lambda self: 2
+    assert m.test_override_cache(obj) == 1
+    assert m.test_override_cache(derived) == 2
+    del Test.func
+    assert m.test_override_cache(obj) == 0
+    assert m.test_override_cache(derived) == 2
+    del Derived.func
+    assert m.test_override_cache(obj) == 0
+    assert m.test_override_cache(derived) == 0
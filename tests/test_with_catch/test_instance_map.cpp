@@ -0,0 +1,122 @@
+#include "pybind11/pybind11.h"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// instance_map is only a separate type (flat_instance_map) with internals version 13 and newer;
+// before that it is the std::unordered_multimap these tests compare it with.
+#if PYBIND11_INTERNALS_VERSION >= 13
+
+namespace py = pybind11;
+
+using py::detail::instance;
+using py::detail::instance_map;
+using reference_map = std::unordered_multimap<const void *, instance *>;
+
+namespace {
+
+// Fake addresses; they are only hashed and compared, never dereferenced.
+const void *address(std::uintptr_t i) { return reinterpret_cast<const void *>(0x1000 + 16 * i); }
+instance *fake_instance(std::uintptr_t i) { return reinterpret_cast<instance *>(0x8000 + 64 * i); }
+
+std::vector<instance *> values_for(instance_map &map, const void *key) {
+    std::vector<instance *> result;
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        REQUIRE(it->first == key);
+        result.push_back(it->second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<instance *> values_for(const reference_map &map, const void *key) {
+    std::vector<instance *> result;
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(it->second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Same pattern as deregister_instance_impl()
+bool erase_one(instance_map &map, const void *key, instance *value) {
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == value) {
+            map.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool erase_one(reference_map &map, const void *key, instance *value) {
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == value) {
+            map.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("instance_map empty") {
+    instance_map map;
+    REQUIRE(map.size() == 0);
+    REQUIRE(values_for(map, address(1)).empty());
+    REQUIRE_FALSE(erase_one(map, address(1), fake_instance(1)));
+}
+
+TEST_CASE("instance_map multiple instances per address") {
+    instance_map map;
+    map.emplace(address(1), fake_instance(1));
+    map.emplace(address(1), fake_instance(2));
+    map.emplace(address(2), fake_instance(3));
+    map.emplace(address(1), fake_instance(4));
+    REQUIRE(map.size() == 4);
+    REQUIRE(values_for(map, address(1))
+            == std::vector<instance *>{fake_instance(1), fake_instance(2), fake_instance(4)});
+
+    REQUIRE(erase_one(map, address(1), fake_instance(2)));
+    REQUIRE_FALSE(erase_one(map, address(1), fake_instance(2)));
+    REQUIRE(values_for(map, address(1))
+            == std::vector<instance *>{fake_instance(1), fake_instance(4)});
+    REQUIRE(values_for(map, address(2)) == std::vector<instance *>{fake_instance(3)});
+    REQUIRE(map.size() == 3);
+}
+
+TEST_CASE("instance_map matches std::unordered_multimap") {
+    instance_map map;
+    reference_map expected;
+    std::mt19937 rng(12345);
+    const std::uintptr_t num_addresses = 500;
+    for (int step = 0; step < 100000; ++step) {
+        const void *key = address(rng() % num_addresses);
+        instance *value = fake_instance(rng() % 3);
+        // Alternate between phases that mostly register and mostly deregister instances
+        const unsigned register_percentage = (step / 10000) % 2 == 0 ? 70 : 30;
+        if (rng() % 100 < register_percentage) {
+            map.emplace(key, value);
+            expected.emplace(key, value);
+        } else {
+            REQUIRE(erase_one(map, key, value) == erase_one(expected, key, value));
+        }
+        if (step % 1000 == 0) {
+            REQUIRE(map.size() == expected.size());
+            for (std::uintptr_t i = 0; i < num_addresses; ++i) {
+                REQUIRE(values_for(map, address(i)) == values_for(expected, address(i)));
+            }
+        }
+    }
+}
+
+#endif // PYBIND11_INTERNALS_VERSION >= 13